@@ -34,6 +34,7 @@
 #include "cuda-sim/cuda-sim.h"
 #include "gpgpu-sim/gpu-sim.h"
 #include "gpgpu-sim/shader.h"
+#include "gpgpu-sim/checkpoint.h"
 #include "option_parser.h"
 #include <algorithm>
 
@@ -83,6 +84,9 @@ void gpgpu_functional_sim_config::reg_options(class OptionParser * opp)
    option_parser_register(opp, "-gpgpu_ptx_inst_debug_thread_uid", OPT_INT32, &g_ptx_inst_debug_thread_uid, 
                "Thread UID for executed instructions' debug output", 
                "1");
+   option_parser_register(opp, "-gpgpu_ptx_warp_alu_exec", OPT_BOOL, &m_warp_alu_exec, 
+               "Execute register-only ALU instructions for a whole warp at once (functional model)", 
+               "1");
 }
 
 void gpgpu_functional_sim_config::ptx_set_tex_cache_linesize(unsigned linesize)
@@ -93,9 +97,9 @@ void gpgpu_functional_sim_config::ptx_set_tex_cache_linesize(unsigned linesize)
 gpgpu_t::gpgpu_t( const gpgpu_functional_sim_config &config )
     : m_function_model_config(config)
 {
-   m_global_mem = new memory_space_impl<8192>("global",64*1024);
-   m_tex_mem = new memory_space_impl<8192>("tex",64*1024);
-   m_surf_mem = new memory_space_impl<8192>("surf",64*1024);
+   m_global_mem = new paged_memory_space("global");
+   m_tex_mem = new paged_memory_space("tex");
+   m_surf_mem = new paged_memory_space("surf");
 
    m_dev_malloc=GLOBAL_HEAP_START; 
 
@@ -103,6 +107,75 @@ gpgpu_t::gpgpu_t( const gpgpu_functional_sim_config &config )
       ptx_inst_debug_file = fopen(m_function_model_config.get_ptx_inst_debug_file(), "w");
 }
 
+void gpgpu_t::save_functional_checkpoint( FILE *fp ) const
+{
+   ckpt_write_tag(fp, "functional"); 
+   ckpt_write(fp, m_dev_malloc); 
+   m_global_mem->save_checkpoint(fp); 
+   m_tex_mem->save_checkpoint(fp); 
+   m_surf_mem->save_checkpoint(fp); 
+
+   // texture bindings, by texture name (the textureReference lives in the host program)
+   ckpt_write_tag(fp, "tex_bindings"); 
+   size_t n_bound = m_TextureRefToCudaArray.size(); 
+   ckpt_write(fp, n_bound); 
+   std::map<const struct textureReference*,const struct cudaArray*>::const_iterator t;
+   for (t = m_TextureRefToCudaArray.begin(); t != m_TextureRefToCudaArray.end(); ++t) {
+      std::string name; 
+      std::map<std::string, const struct textureReference*>::const_iterator n;
+      for (n = m_NameToTextureRef.begin(); n != m_NameToTextureRef.end(); ++n) {
+         if (n->second == t->first) name = n->first; 
+      }
+      if (name.empty()) {
+         printf("GPGPU-Sim PTX: ERROR ** cannot checkpoint a texture binding without a registered texture name\n");
+         abort();
+      }
+      size_t name_len = name.size(); 
+      ckpt_write(fp, name_len); 
+      ckpt_write_raw(fp, name.c_str(), name_len); 
+      ckpt_write(fp, *t->second); 
+   }
+}
+
+// With memory_only, only the memory content is restored: the allocator and the texture bindings 
+// are left to the host program, which is still running the API calls that precede the resumed kernel. 
+void gpgpu_t::load_functional_checkpoint( FILE *fp, bool memory_only )
+{
+   ckpt_check_tag(fp, "functional"); 
+   unsigned long long dev_malloc; 
+   ckpt_read(fp, dev_malloc); 
+   if (!memory_only) 
+      m_dev_malloc = dev_malloc; 
+   m_global_mem->load_checkpoint(fp); 
+   m_tex_mem->load_checkpoint(fp); 
+   m_surf_mem->load_checkpoint(fp); 
+   if (memory_only) 
+      return; 
+
+   ckpt_check_tag(fp, "tex_bindings"); 
+   size_t n_bound; 
+   ckpt_read(fp, n_bound); 
+   for (size_t b = 0; b < n_bound; b++) {
+      size_t name_len; 
+      ckpt_read(fp, name_len); 
+      std::string name(name_len, '\0'); 
+      ckpt_read_raw(fp, &name[0], name_len); 
+      struct cudaArray saved; 
+      ckpt_read(fp, saved); 
+      std::map<std::string, const struct textureReference*>::const_iterator n = m_NameToTextureRef.find(name);
+      if (n == m_NameToTextureRef.end()) {
+         printf("GPGPU-Sim PTX: ERROR ** texture '%s' in the checkpoint is not registered by the program\n", name.c_str());
+         abort();
+      }
+      std::map<const struct textureReference*,const struct cudaArray*>::const_iterator t = m_TextureRefToCudaArray.find(n->second);
+      if (t != m_TextureRefToCudaArray.end() && memcmp(t->second, &saved, sizeof(saved)) == 0) 
+         continue; // the host program has already made the same binding
+      struct cudaArray *array = (struct cudaArray*) malloc(sizeof(struct cudaArray)); 
+      *array = saved; 
+      gpgpu_ptx_sim_bindTextureToArray(n->second, array); 
+   }
+}
+
 address_type line_size_based_tag_func(new_addr_type address, new_addr_type line_size)
 {
    //gives the tag for an address based on a given line size
@@ -537,10 +610,12 @@ void warp_inst_t::generate_access_tm( unsigned shader_id, bool is_write, mem_acc
             warp_info.m_shader->translate_local_memaddr((next_write_entry*2+1) * word_size + tm_warp_info::write_log_offset,
                                                         wtid, word_size); 
          m_accessq.push_back( mem_access_t(LOCAL_ACC_W,next_data_block,data_block_size,true,m_warp_active_mask,full_byte_mask) );
+         m_accessq.back().set_tx_log(); 
          addr_t next_atag_block = 
             warp_info.m_shader->translate_local_memaddr(next_write_entry*2 * word_size + tm_warp_info::write_log_offset,
                                                         wtid, addr_size); 
          m_accessq.push_back( mem_access_t(LOCAL_ACC_W,next_atag_block,atag_block_size,true,empty_mask,full_byte_mask) );
+         m_accessq.back().set_tx_log(); 
 
          // printf("tm_store: wtlog=%d atag_block=%#08x data_block=%#08x m_accessqsize=%zd\n", next_write_entry, next_atag_block, next_data_block, m_accessq.size());
          g_debug_tm_write_log_entry_written += 2; 
@@ -627,6 +702,7 @@ void warp_inst_t::generate_access_tm( unsigned shader_id, bool is_write, mem_acc
           // HACK: for data blocks in other entries, just create a store to make sure the entry is allocated in cache 
           for (unsigned w = 1; w * word_size < access_data_size; w++) {
              m_accessq.push_back( mem_access_t(LOCAL_ACC_W,data_block[w],data_block_size,true,empty_mask,full_byte_mask) );
+             m_accessq.back().set_tx_log(); 
              m_txlog_fill_accesses += 1; // tell the ldst_unit to not treat these accesses as pending writebacks 
              // printf("tm_load: rdlog=%d data_block=%#08x m_accessqsize=%zd\n", read_entry + w, data_block[w], m_accessq.size());
           }
@@ -638,6 +714,7 @@ void warp_inst_t::generate_access_tm( unsigned shader_id, bool is_write, mem_acc
                 warp_info.m_shader->translate_local_memaddr(next_read_entry*2 * word_size + tm_warp_info::read_log_offset,
                                                             wtid, addr_size);
              m_accessq.push_back( mem_access_t(LOCAL_ACC_W,next_atag_block,atag_block_size,true,empty_mask,full_byte_mask) );
+             m_accessq.back().set_tx_log(); 
              m_txlog_fill_accesses += 1; // tell the ldst_unit to not treat these accesses as pending writebacks 
 
              // printf("tm_load: rdlog=%d atag_block=%#08x data_block=%#08x m_accessqsize=%zd\n", next_read_entry, next_atag_block, next_data_block, m_accessq.size());
@@ -667,12 +744,14 @@ void warp_inst_t::generate_access_tm( unsigned shader_id, bool is_write, mem_acc
                   warp_info.m_shader->translate_local_memaddr((w*2+1) * word_size + tm_warp_info::write_log_offset,
                                                               wtid, word_size); 
                m_accessq.push_back( mem_access_t(LOCAL_ACC_R,next_data_block,data_block_size,false,empty_mask,full_byte_mask) );
+               m_accessq.back().set_tx_log(); 
             }
             // for each write log entry, generate a load <Address> from local memory 
             addr_t next_atag_block = 
                warp_info.m_shader->translate_local_memaddr(w*2 * word_size + tm_warp_info::write_log_offset,
                                                            wtid, addr_size); 
             m_accessq.push_back( mem_access_t(LOCAL_ACC_R,next_atag_block,atag_block_size,false,empty_mask,full_byte_mask) );
+            m_accessq.back().set_tx_log(); 
 
             // printf("tm_load: wtlog=%d atag_block=%#08x data_block=%#08x m_accessqsize=%zd\n", next_write_entry, next_atag_block, next_data_block, m_accessq.size());
          }
@@ -931,6 +1010,7 @@ void simt_stack::reset()
 {
     m_stack.clear();
     m_in_transaction = false;
+    m_tx_retry = false; 
     m_has_paused_threads = false; 
 }
 
@@ -1153,12 +1233,19 @@ void simt_stack::set_warp(shd_warp_t *w) {
 
 void core_t::execute_warp_inst_t(warp_inst_t &inst, unsigned warpId)
 {
+    const active_mask_t active = inst.get_active_mask();
+    bool warp_executed = false;
+    if( active.any() ) {
+        if(warpId==(unsigned (-1)))
+            warpId = inst.warp_id();
+        // register-only ALU instructions are executed for all lanes at once 
+        warp_executed = ptx_thread_info::ptx_exec_warp_inst(inst, &m_thread[m_warp_size*warpId], m_warp_size);
+    }
     for ( unsigned t=0; t < m_warp_size; t++ ) {
-        if( inst.active(t) ) {
-            if(warpId==(unsigned (-1)))
-                warpId = inst.warp_id();
+        if( active.test(t) ) {
             unsigned tid=m_warp_size*warpId+t;
-            m_thread[tid]->ptx_exec_inst(inst,t);
+            if( !warp_executed )
+                m_thread[tid]->ptx_exec_inst(inst,t);
             
             //virtual function
             checkExecutionStatusAndUpdate(inst,t,tid);
@@ -1212,6 +1299,7 @@ void tm_parallel_pdom_warp_ctx_t::txbegin(address_type tm_restart_pc)
     //TODO: set TOS entry's PC to the insn after txcommit() 
 
     m_in_transaction = true; 
+    m_tx_retry = false; 
 }
 
 void tm_parallel_pdom_warp_ctx_t::txrestart() 
@@ -1233,6 +1321,7 @@ void tm_parallel_pdom_warp_ctx_t::txrestart()
     retry_entry.m_active_mask.reset(); 
 
     m_stack.push_back(texec_entry);
+    m_tx_retry = true; 
 }
 
 // check for correctness conditions when a warp-level transaction is restarted 
@@ -1477,6 +1566,7 @@ void tm_serial_pdom_warp_ctx_t::txbegin(address_type tm_restart_pc)
     tx_start_thread(retry_idx, texec_idx); 
 
     m_in_transaction = true; 
+    m_tx_retry = false; 
 }
 
 // move one thread from retry to transaction entry 
@@ -1518,6 +1608,7 @@ void tm_serial_pdom_warp_ctx_t::txrestart()
 
     tx_start_thread(retry_idx, texec_idx); 
     // no need to reset active mask in retry entry 
+    m_tx_retry = true; 
 } 
 
 void tm_serial_pdom_warp_ctx_t::txabort(unsigned thread_id) 
@@ -343,6 +343,7 @@ public:
     virtual bool check_txrestart_warp_level() { return true; } // check for warp level transaction restart conditions 
     virtual bool check_txcommit_warp_level() { return true; }  // check for warp level transaction commit conditions 
     virtual bool in_transaction() { return m_in_transaction; }
+    bool in_tx_retry() { return m_in_transaction and m_tx_retry; } // re-executing an aborted transaction 
 
     virtual bool is_tm_restarted() { return m_is_tm_restarted; }
     virtual void set_tm_restarted() { m_is_tm_restarted = true; }
@@ -388,6 +389,7 @@ protected:
 
     // void clone_entry(unsigned dst, unsigned src); 
     bool m_in_transaction;
+    bool m_tx_retry; // set by txrestart(), cleared at txbegin() 
 
     bool m_is_tm_restarted;
 
@@ -524,6 +526,7 @@ public:
     const char* get_ptx_inst_debug_file() const  { return g_ptx_inst_debug_file; }
     int         get_ptx_inst_debug_thread_uid() const { return g_ptx_inst_debug_thread_uid; }
     unsigned    get_texcache_linesize() const { return m_texcache_linesize; }
+    bool        warp_alu_exec() const { return m_warp_alu_exec; }
 
 private:
     // PTX options
@@ -537,6 +540,7 @@ private:
     int   g_ptx_inst_debug_thread_uid;
 
     unsigned m_texcache_linesize;
+    int m_warp_alu_exec;
 };
 
 class gpgpu_t {
@@ -553,6 +557,10 @@ public:
     class memory_space *get_tex_memory() { return m_tex_mem; }
     class memory_space *get_surf_memory() { return m_surf_mem; }
 
+    // functional state (device memory content, allocation pointer, texture bindings) in a checkpoint
+    void save_functional_checkpoint( FILE *fp ) const;
+    void load_functional_checkpoint( FILE *fp, bool memory_only = false );
+
     void gpgpu_ptx_sim_bindTextureToArray(const struct textureReference* texref, const struct cudaArray* array);
     void gpgpu_ptx_sim_bindNameToTexture(const char* name, const struct textureReference* texref, int dim, int readmode, int ext);
     const char* gpgpu_ptx_sim_findNamefromTexture(const struct textureReference* texref);
@@ -765,6 +773,8 @@ public:
    new_addr_type get_fill_addr() const { return m_fill_addr; }
    void set_tx_load(new_addr_type fill_addr) { m_fill_addr = fill_addr; m_is_tx_load = true; }
    bool is_tx_load() const { return m_is_tx_load; }
+   void set_tx_log() { m_is_tx_log = true; }
+   bool is_tx_log() const { return m_is_tx_log; }
 
    unsigned get_uid() const { return m_uid; }
 
@@ -798,6 +808,7 @@ private:
       m_req_size = 0;
       m_fill_addr = 0;
       m_is_tx_load = false; 
+      m_is_tx_log = false; 
    }
 
    unsigned      m_uid;
@@ -810,6 +821,7 @@ private:
 
    new_addr_type m_fill_addr; // TM: where the fetched data is stored in cache 
    bool          m_is_tx_load;
+   bool          m_is_tx_log; // TM: store to transaction log (address tag or data block) 
 
    // HACK for the LSU HPCA2016 Early Abort paper
    std::map<new_addr_type, active_mask_t> m_word_active_mask;
@@ -1205,6 +1217,7 @@ public:
         return m_warp_active_mask[n] && m_per_scalar_thread_valid && 
             (m_per_scalar_thread[n].logical_tm_callback.function!=NULL);
     }
+    bool per_scalar_thread_valid() const { return m_per_scalar_thread_valid; }
     new_addr_type get_addr( unsigned n ) const
     {
         assert( m_per_scalar_thread_valid );
@@ -1,5 +1,6 @@
 #include "bloomfilter.h"
 #include "hashfunc.h"
+#include "../gpgpu-sim/checkpoint.h"
 #include <map>
 #include <set>
 
@@ -1499,6 +1500,18 @@ void versioning_hashtable::print(FILE *fout) const
    }
 }
 
+void versioning_hashtable::save_checkpoint(FILE *fp) const 
+{
+   ckpt_write(fp, m_size); 
+   ckpt_write_raw(fp, &m_version[0], m_size * sizeof(unsigned int)); 
+}
+
+void versioning_hashtable::load_checkpoint(FILE *fp) 
+{
+   ckpt_check(fp, m_size, "bloom filter size"); 
+   ckpt_read_raw(fp, &m_version[0], m_size * sizeof(unsigned int)); 
+}
+
 void versioning_hashtable::unit_test()
 {
    versioning_hashtable vht(1024, 1);
@@ -1603,6 +1616,20 @@ void versioning_bloomfilter::clear()
    }
 }
 
+void versioning_bloomfilter::save_checkpoint(FILE *fp) const
+{
+   for (size_t n = 0; n < m_n_hashes; n++) {
+      m_hashtables[n]->save_checkpoint(fp); 
+   }
+}
+
+void versioning_bloomfilter::load_checkpoint(FILE *fp)
+{
+   for (size_t n = 0; n < m_n_hashes; n++) {
+      m_hashtables[n]->load_checkpoint(fp); 
+   }
+}
+
 // print hashtable content 
 void versioning_bloomfilter::print(FILE *fout) const
 {
@@ -324,6 +324,10 @@ public:
    // print hashtable content 
    void print(FILE *fout) const; 
 
+   // save/restore versions in a checkpoint 
+   void save_checkpoint(FILE *fp) const; 
+   void load_checkpoint(FILE *fp); 
+
    // exposed hash function
    unsigned int hash(addr_t addr) const { return m_hash_funct_ptr(m_size, addr); } 
 
@@ -363,6 +367,10 @@ public:
    // print hashtable content 
    void print(FILE *fout) const; 
 
+   // save/restore versions in a checkpoint 
+   void save_checkpoint(FILE *fp) const; 
+   void load_checkpoint(FILE *fp); 
+
    // accessor helper functions
    unsigned int size() const { return m_size; }
    size_t n_hashes() const { return m_n_hashes; }
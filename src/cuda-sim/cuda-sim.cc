@@ -278,6 +278,9 @@ void function_info::ptx_assemble()
    printf("GPGPU-Sim PTX: ... done pre-decoding instructions for \'%s\'.\n", m_name.c_str() );
    fflush(stdout);
 
+   // the parser numbers the register symbols of a function densely, size its register frames to match 
+   m_num_reg_slots = m_symtab->num_reg_slots();
+
    m_assembled = true;
 }
 
@@ -787,6 +790,60 @@ static unsigned datatype2size( unsigned data_type )
    return data_size; 
 }
 
+// operand that get_operand_value()/set_operand_value() read or write as a plain register 
+// (or literal) value, with no memory dereference, vector, split or lo/hi handling 
+static bool is_warp_alu_operand( const operand_info &op, bool is_src )
+{
+   if ( op.is_vector() || op.get_double_operand_type() != 0 || op.get_operand_lohi() != 0 ) 
+      return false;
+   if ( op.get_addr_space() != undefined_space ) 
+      return false;
+   if ( !is_src ) 
+      return op.is_reg();
+   return !op.get_operand_neg() && (op.is_reg() || op.is_literal());
+}
+
+ptx_instruction::warp_alu_t ptx_instruction::decode_warp_alu() const
+{
+   if ( is_exit() ) 
+      return WARP_ALU_NONE;
+   unsigned n_srcs = (m_opcode == MOV_OP)? 1 : 2;
+   if ( get_num_operands() != n_srcs + 1 || !is_warp_alu_operand(dst(),false) ) 
+      return WARP_ALU_NONE;
+   if ( !is_warp_alu_operand(src1(),true) || (n_srcs == 2 && !is_warp_alu_operand(src2(),true)) ) 
+      return WARP_ALU_NONE;
+
+   unsigned type = get_type();
+   if ( type == BB64_TYPE || type == BB128_TYPE || type == FF64_TYPE ) 
+      return WARP_ALU_NONE;
+   switch ( m_opcode ) {
+   case MOV_OP: 
+      return (type == PRED_TYPE)? WARP_ALU_NONE : WARP_ALU_MOV;
+   case ADD_OP: 
+      if ( m_rounding_mode != RN_OPTION ) 
+         return WARP_ALU_NONE;
+      switch ( type ) {
+      case S32_TYPE: case U32_TYPE: return WARP_ALU_ADD32;
+      case S64_TYPE: case U64_TYPE: return WARP_ALU_ADD64;
+      case F32_TYPE: return WARP_ALU_ADDF32;
+      default: return WARP_ALU_NONE;
+      }
+   case SUB_OP: 
+      switch ( type ) {
+      case S32_TYPE: case U32_TYPE: case B32_TYPE: return WARP_ALU_SUB32;
+      case S64_TYPE: case U64_TYPE: case B64_TYPE: return WARP_ALU_SUB64;
+      case F32_TYPE: return WARP_ALU_SUBF32;
+      default: return WARP_ALU_NONE;
+      }
+   case AND_OP: return (type == PRED_TYPE)? WARP_ALU_NONE : WARP_ALU_AND;
+   case OR_OP:  return (type == PRED_TYPE)? WARP_ALU_NONE : WARP_ALU_OR;
+   case XOR_OP: return (type == PRED_TYPE)? WARP_ALU_NONE : WARP_ALU_XOR;
+   case SETP_OP: return WARP_ALU_SETP;
+   default: 
+      return WARP_ALU_NONE;
+   }
+}
+
 void ptx_instruction::pre_decode()
 {
    pc = m_PC;
@@ -814,13 +871,14 @@ void ptx_instruction::pre_decode()
    bool has_dst = false ;
 
    switch ( get_opcode() ) {
-#define OP_DEF(OP,FUNC,STR,DST,CLASSIFICATION) case OP: has_dst = (DST!=0); break;
+#define OP_DEF(OP,FUNC,STR,DST,CLASSIFICATION) case OP: has_dst = (DST!=0); m_exec_impl = FUNC; m_op_classification = CLASSIFICATION; break;
 #include "opcodes.def"
 #undef OP_DEF
    default:
       printf( "Execution error: Invalid opcode (0x%x)\n", get_opcode() );
       break;
    }
+   m_warp_alu = decode_warp_alu();
 
    switch( m_cache_option ) {
    case CA_OPTION: cache_op = CACHE_ALL; break;
@@ -1224,11 +1282,13 @@ void ptx_thread_info::ptx_exec_inst( warp_inst_t &inst, unsigned lane_id)
          *((warp_inst_t*)pJ) = inst; // copy active mask information
          pI = pJ;
       }
-      switch ( pI->get_opcode() ) {
-#define OP_DEF(OP,FUNC,STR,DST,CLASSIFICATION) case OP: FUNC(pI,this); op_classification = CLASSIFICATION; break;
-#include "opcodes.def"
-#undef OP_DEF
-      default: printf( "Execution error: Invalid opcode (0x%x)\n", pI->get_opcode() ); break;
+      // handler resolved at pre_decode time instead of switching on the opcode 
+      ptx_instruction::exec_impl_t exec_impl = pI->get_exec_impl();
+      if ( exec_impl != NULL ) {
+         exec_impl(pI,this);
+         op_classification = pI->get_op_classification();
+      } else {
+         printf( "Execution error: Invalid opcode (0x%x)\n", pI->get_opcode() );
       }
 
       if (in_transaction) {
@@ -1276,9 +1336,20 @@ void ptx_thread_info::ptx_exec_inst( warp_inst_t &inst, unsigned lane_id)
       if(pI->is_exit())
          exit_impl(pI,this);
    }
-   
 
+   ptx_exec_inst_retire(inst, lane_id, pI, pc, skip, op_classification);
+
+   } catch ( int x  ) {
+      printf("GPGPU-Sim PTX: ERROR (%d) executing intruction (%s:%u)\n", x, pI->source_file(), pI->source_line() );
+      printf("GPGPU-Sim PTX:       '%s'\n", pI->get_source() );
+      abort();
+   }
+}
 
+// Per-thread bookkeeping after the instruction at pc has been executed (or predicated off): 
+// debug output, pc update, instruction statistics and the lane's memory access information. 
+void ptx_thread_info::ptx_exec_inst_retire( warp_inst_t &inst, unsigned lane_id, const ptx_instruction *pI, addr_t pc, bool skip, int op_classification )
+{
    const gpgpu_functional_sim_config &config = m_gpu->get_config();
    
    // Output instruction information to file and stdout
@@ -1389,14 +1460,148 @@ void ptx_thread_info::ptx_exec_inst( warp_inst_t &inst, unsigned lane_id)
       inst.data_size = insn_data_size; // simpleAtomicIntrinsics
       assert( inst.memory_op == insn_memory_op );
    } 
+}
 
-   } catch ( int x  ) {
-      printf("GPGPU-Sim PTX: ERROR (%d) executing intruction (%s:%u)\n", x, pI->source_file(), pI->source_line() );
-      printf("GPGPU-Sim PTX:       '%s'\n", pI->get_source() );
-      abort();
+bool CmpOp( int type, ptx_reg_t a, ptx_reg_t b, unsigned cmpop );
+
+// gather the 64 bit value of a register/literal source operand for each of the n lanes 
+static void warp_alu_gather( const operand_info &op, ptx_thread_info **threads, const unsigned *lanes, unsigned n, unsigned long long *values )
+{
+   if ( op.is_literal() ) {
+      unsigned long long v = op.get_literal_value().u64;
+      for ( unsigned i=0; i < n; i++ ) 
+         values[i] = v;
+   } else {
+      const symbol *reg = op.get_symbol();
+      for ( unsigned i=0; i < n; i++ ) 
+         values[i] = threads[lanes[i]]->get_reg(reg).u64;
    }
 }
 
+static inline float warp_alu_f32( unsigned long long bits )
+{
+   ptx_reg_t r;
+   r.u64 = bits;
+   return r.f32;
+}
+
+static inline unsigned long long warp_alu_f32_bits( float f )
+{
+   ptx_reg_t r;
+   r.f32 = f;
+   return r.u64;
+}
+
+// Execute a register/literal-only ALU instruction (see ptx_instruction::decode_warp_alu) for all 
+// active lanes of a warp at once: decode once, gather the source operands of every lane, compute 
+// the results in one loop over the lanes and scatter them back to the lanes' registers. The 
+// values written are the ones the per-thread handlers would write. Returns false, leaving the 
+// warp untouched, when the instruction has to go through ptx_exec_inst() one lane at a time. 
+bool ptx_thread_info::ptx_exec_warp_inst( warp_inst_t &inst, ptx_thread_info **threads, unsigned warp_size )
+{
+   assert( warp_size <= MAX_WARP_SIZE );
+   const active_mask_t active = inst.get_active_mask(); // lanes predicated off below are retired too 
+   unsigned first = 0;
+   while ( first < warp_size && !active.test(first) ) 
+      first++;
+   if ( first == warp_size ) 
+      return false;
+
+   ptx_thread_info *lead = threads[first];
+   const gpgpu_functional_sim_config &config = lead->m_gpu->get_config();
+   if ( !config.warp_alu_exec() || g_debug_execution >= 6 || config.get_ptx_inst_debug_to_file() ) 
+      return false;
+   addr_t pc = inst.pc;
+   const ptx_instruction *pI = lead->m_func_info->get_instruction(pc);
+   ptx_instruction::warp_alu_t op = pI->get_warp_alu();
+   if ( op == ptx_instruction::WARP_ALU_NONE ) 
+      return false;
+   for ( unsigned t=first; t < warp_size; t++ ) {
+      if ( active.test(t) && (threads[t]->m_tm_manager != NULL || threads[t]->is_done()) ) 
+         return false; // transactional register tracking and error reporting stay per thread 
+   }
+   assert( inst.in_transaction == false );
+
+   // per lane: advance the pc and evaluate the guard predicate 
+   unsigned lanes[MAX_WARP_SIZE];
+   unsigned n = 0;
+   for ( unsigned t=first; t < warp_size; t++ ) {
+      if ( !active.test(t) ) 
+         continue;
+      ptx_thread_info *thread = threads[t];
+      assert( thread->next_instr() == pc );
+      thread->set_npc( pc + pI->inst_size() );
+      thread->clearRPC();
+      thread->m_last_set_operand_value.u64 = 0;
+      bool skip = false;
+      if ( pI->has_pred() ) {
+         const operand_info &pred = pI->get_pred();
+         ptx_reg_t pred_value = thread->get_operand_value(pred, pred, PRED_TYPE, thread, 0);
+         if ( pI->get_pred_mod() == -1 ) 
+            skip = (pred_value.pred & 0x0001) ^ pI->get_pred_neg(); //ptxplus inverts the zero flag
+         else 
+            skip = !pred_lookup(pI->get_pred_mod(), pred_value.pred & 0x000F);
+      }
+      if ( skip ) {
+         inst.predicate_off(t);
+      } else {
+         pI->m_tm_access_info.m_writelog_access.reset(t); 
+         pI->m_tm_access_info.m_timeout_validation_fail.reset(t); 
+         lanes[n++] = t;
+      }
+   }
+
+   // gather, compute, scatter 
+   unsigned long long a[MAX_WARP_SIZE], b[MAX_WARP_SIZE], r[MAX_WARP_SIZE];
+   const unsigned long long M = 0xFFFFFFFFULL;
+   warp_alu_gather(pI->src1(), threads, lanes, n, a);
+   if ( op != ptx_instruction::WARP_ALU_MOV ) 
+      warp_alu_gather(pI->src2(), threads, lanes, n, b);
+   switch ( op ) {
+   case ptx_instruction::WARP_ALU_MOV:   for ( unsigned i=0; i < n; i++ ) r[i] = a[i]; break;
+   case ptx_instruction::WARP_ALU_ADD32: for ( unsigned i=0; i < n; i++ ) r[i] = (a[i] & M) + (b[i] & M); break;
+   case ptx_instruction::WARP_ALU_ADD64: for ( unsigned i=0; i < n; i++ ) r[i] = a[i] + b[i]; break;
+   case ptx_instruction::WARP_ALU_SUB32: for ( unsigned i=0; i < n; i++ ) r[i] = (a[i] & M) - (b[i] & M) + 0x100000000ULL; break;
+   case ptx_instruction::WARP_ALU_SUB64: for ( unsigned i=0; i < n; i++ ) r[i] = a[i] - b[i]; break;
+   case ptx_instruction::WARP_ALU_AND:   for ( unsigned i=0; i < n; i++ ) r[i] = a[i] & b[i]; break;
+   case ptx_instruction::WARP_ALU_OR:    for ( unsigned i=0; i < n; i++ ) r[i] = a[i] | b[i]; break;
+   case ptx_instruction::WARP_ALU_XOR:   for ( unsigned i=0; i < n; i++ ) r[i] = a[i] ^ b[i]; break;
+   case ptx_instruction::WARP_ALU_ADDF32: 
+      for ( unsigned i=0; i < n; i++ ) 
+         r[i] = warp_alu_f32_bits( warp_alu_f32(a[i]) + warp_alu_f32(b[i]) );
+      break;
+   case ptx_instruction::WARP_ALU_SUBF32: 
+      for ( unsigned i=0; i < n; i++ ) 
+         r[i] = warp_alu_f32_bits( warp_alu_f32(a[i]) - warp_alu_f32(b[i]) );
+      break;
+   case ptx_instruction::WARP_ALU_SETP: {
+      unsigned type = pI->get_type();
+      unsigned cmpop = pI->get_cmpop();
+      for ( unsigned i=0; i < n; i++ ) {
+         ptx_reg_t x, y;
+         x.u64 = a[i];
+         y.u64 = b[i];
+         r[i] = (CmpOp(type,x,y,cmpop) == 0)? 1 : 0; //ptxplus uses "1" for a set zero flag
+      }
+      break;
+   }
+   default: abort();
+   }
+   const symbol *dst = pI->dst().get_symbol();
+   for ( unsigned i=0; i < n; i++ ) {
+      ptx_reg_t data;
+      data.u64 = r[i];
+      threads[lanes[i]]->set_reg(dst, data);
+   }
+
+   int op_classification = pI->get_op_classification();
+   for ( unsigned t=first; t < warp_size; t++ ) {
+      if ( active.test(t) ) 
+         threads[t]->ptx_exec_inst_retire(inst, t, pI, pc, !inst.active(t), op_classification);
+   }
+   return true;
+}
+
 void set_param_gpgpu_num_shaders(int num_shaders)
 {
    gpgpu_param_num_shaders = num_shaders;
@@ -1822,7 +2027,7 @@ void functionalCoreSim::initializeCTA()
     
     //get threads for a cta
     for(unsigned i=0; i<m_kernel->threads_per_cta();i++) {
-        ptx_sim_init_thread(*m_kernel,&m_thread[i],0,i,m_kernel->threads_per_cta()-i,m_kernel->threads_per_cta(),this,0,i/m_warp_size,(gpgpu_t*)m_gpu, true);
+        ptx_sim_init_thread(*m_kernel,&m_thread[i],m_sid,i,m_kernel->threads_per_cta()-i,m_kernel->threads_per_cta(),this,0,i/m_warp_size,(gpgpu_t*)m_gpu, true);
         assert(m_thread[i]!=NULL && !m_thread[i]->is_done());
         ctaLiveThreads++;
     }
@@ -1870,6 +2075,7 @@ void functionalCoreSim::executeWarp(unsigned i, bool &allAtBarrier, bool & someO
     if(!m_warpAtBarrier[i] && m_liveThreadCount[i]!=0){
         warp_inst_t inst =getExecuteWarp(i);
         execute_warp_inst_t(inst,i);
+        m_gpu->functional_warmup(inst);
         if(inst.isatomic()) inst.do_atomic(true);
         if(inst.op==BARRIER_OP || inst.op==MEMORY_BARRIER_OP ) m_warpAtBarrier[i]=true;
         updateSIMTStack( i, &inst );
@@ -41,6 +41,7 @@ class symbol_table;
 
 extern const char *g_gpgpusim_version_string;
 extern int g_ptx_sim_mode;
+extern unsigned g_ptx_sim_num_insn;
 extern int g_debug_execution;
 extern int g_debug_thread_uid;
 extern void ** g_inst_classification_stat;
@@ -85,8 +86,9 @@ void set_param_gpgpu_num_shaders(int num_shaders);
 class functionalCoreSim: public core_t
 {    
 public:
-    functionalCoreSim(kernel_info_t * kernel, gpgpu_sim *g, unsigned warp_size)
-        : core_t( g, kernel, warp_size, kernel->threads_per_cta() )
+    // the CTA runs with the hardware ids (hw CTA 0, tid 0..) of shader core sid 
+    functionalCoreSim(kernel_info_t * kernel, gpgpu_sim *g, unsigned warp_size, unsigned sid = 0)
+        : core_t( g, kernel, warp_size, kernel->threads_per_cta(), sid ), m_sid(sid)
     {
         m_warpAtBarrier =  new bool [m_warp_count];
         m_liveThreadCount = new unsigned [m_warp_count];
@@ -126,6 +128,7 @@ private:
     //each warp live thread count and barrier indicator
     unsigned * m_liveThreadCount;
     bool* m_warpAtBarrier;
+    unsigned m_sid;
 };
 
 #define RECONVERGE_RETURN_PC ((address_type)-2)
@@ -54,17 +54,60 @@ const char *g_opcode_string[NUM_OPCODES] = {
 };
 
 void inst_not_implemented( const ptx_instruction * pI ) ;
-ptx_reg_t srcOperandModifiers(ptx_reg_t opData, operand_info opInfo, operand_info dstInfo, unsigned type, ptx_thread_info *thread);
+ptx_reg_t srcOperandModifiers(ptx_reg_t opData, const operand_info &opInfo, const operand_info &dstInfo, unsigned type, ptx_thread_info *thread);
 
 void sign_extend( ptx_reg_t &data, unsigned src_size, const operand_info &dst );
 
+ptx_reg_t* ptx_reg_frame::find( const symbol *reg )
+{
+   unsigned slot = reg->reg_slot();
+   if( slot < m_syms.size() && m_syms[slot] == reg ) 
+      return &m_values[slot];
+   if( m_spill.empty() ) 
+      return NULL;
+   tr1_hash_map<const symbol*,ptx_reg_t>::iterator i = m_spill.find(reg);
+   return (i != m_spill.end())? &(i->second) : NULL;
+}
+
+void ptx_reg_frame::set( const symbol *reg, const ptx_reg_t &value )
+{
+   (*this)[reg] = value;
+}
+
+ptx_reg_t& ptx_reg_frame::operator[]( const symbol *reg )
+{
+   ptx_reg_t *value = find(reg);
+   if( value != NULL ) 
+      return *value;
+   m_n_defined++;
+   unsigned slot = reg->reg_slot();
+   if( slot != (unsigned)-1 ) {
+      if( slot >= m_syms.size() ) 
+         reserve_slots(slot + 1);
+      if( m_syms[slot] == NULL ) {
+         m_syms[slot] = reg;
+         m_values[slot] = ptx_reg_t();
+         return m_values[slot];
+      }
+   }
+   return m_spill[reg];
+}
+
+void ptx_reg_frame::reserve_slots( unsigned n_slots )
+{
+   if( n_slots > m_syms.size() ) {
+      m_syms.resize(n_slots, NULL);
+      m_values.resize(n_slots);
+   }
+}
+
 void ptx_thread_info::set_reg( const symbol *reg, const ptx_reg_t &value ) 
 {
    assert( reg != NULL );
-   if( reg->name() == "_" ) return;
+   if( reg->is_underscore() ) return;
    assert( !m_regs.empty() );
    assert( reg->uid() > 0 );
-   m_regs.back()[ reg ] = value;
+   m_regs.back().set( reg, value );
    if (m_enable_debug_trace ) 
       m_debug_trace_regs_modified.back()[ reg ] = value;
    m_last_set_operand_value = value;
@@ -75,8 +118,8 @@ ptx_reg_t ptx_thread_info::get_reg( const symbol *reg )
    static bool unfound_register_warned = false;
    assert( reg != NULL );
    assert( !m_regs.empty() );
-   reg_map_t::iterator regs_iter = m_regs.back().find(reg);
-   if (regs_iter == m_regs.back().end()) {
+   ptx_reg_t *value = m_regs.back().find(reg);
+   if (value == NULL) {
       assert( reg->type()->get_key().is_reg() );
       const std::string &name = reg->name();
       unsigned call_uid = m_callstack.back().m_call_uid;
@@ -90,14 +133,14 @@ ptx_reg_t ptx_thread_info::get_reg( const symbol *reg )
                  file_loc.c_str(), name.c_str(), call_uid );
           unfound_register_warned = true;
       }
-      regs_iter = m_regs.back().find(reg);
+      value = m_regs.back().find(reg);
    }
    if (m_enable_debug_trace ) 
-      m_debug_trace_regs_read.back()[ reg ] = regs_iter->second;
-   return regs_iter->second;
+      m_debug_trace_regs_read.back()[ reg ] = *value;
+   return *value;
 }
 
-ptx_reg_t ptx_thread_info::get_operand_value( const operand_info &op, operand_info dstInfo, unsigned opType, ptx_thread_info *thread, int derefFlag )
+ptx_reg_t ptx_thread_info::get_operand_value( const operand_info &op, const operand_info &dstInfo, unsigned opType, ptx_thread_info *thread, int derefFlag )
 {
    ptx_reg_t result, tmp;
    
@@ -353,10 +396,10 @@ void ptx_thread_info::get_vector_operand_values( const operand_info &op, ptx_reg
    for (int idx = num_elements - 1; idx >= 0; --idx) {
       const symbol *sym = NULL;
       sym = op.vec_symbol(idx);
-      if( strcmp(sym->name().c_str(),"_") != 0) {
-         reg_map_t::iterator reg_iter = m_regs.back().find(sym);
-         assert( reg_iter != m_regs.back().end() );
-         ptx_regs[idx] = reg_iter->second;
+      if( !sym->is_underscore() ) {
+         const ptx_reg_t *value = m_regs.back().find(sym);
+         assert( value != NULL );
+         ptx_regs[idx] = *value;
       }
    }
 }
@@ -1331,7 +1374,11 @@ void tbeginv_call( const ptx_instruction *pI, ptx_thread_info *thread )
    #endif
    assert(pI->is_tbegin == true);
    // Insert tbegin handler function call here
-   thread->tx_begin(pI,thread->get_gpu()->get_config().shader_config().tm_uarch_model >= 20 );
+   // threads executed functionally (e.g. before the region of interest) run the transaction 
+   // in non-timing mode, without a commit unit to resolve conflicts and commit for them 
+   bool timing_mode = thread->get_gpu()->get_config().shader_config().tm_uarch_model >= 20 
+                      and not thread->isInFunctionalSimulationMode(); 
+   thread->tx_begin(pI, timing_mode);
 }
 
 void tcommitv_call( const ptx_instruction *pI, ptx_thread_info *thread ) 
@@ -1349,8 +1396,9 @@ void tcommitv_call( const ptx_instruction *pI, ptx_thread_info *thread )
    #endif
    assert(pI->is_tcommit == true);
    // Insert tcommit handler function call here
-   if( thread->get_gpu()->get_config().shader_config().tm_uarch_model < 20 
-       and thread->get_gpu()->get_config().shader_config().timing_mode_vb_commit == false )
+   if( (thread->get_gpu()->get_config().shader_config().tm_uarch_model < 20 
+        and thread->get_gpu()->get_config().shader_config().timing_mode_vb_commit == false) 
+       or thread->isInFunctionalSimulationMode() )
       thread->tx_commit(pI);
 }
 
@@ -1396,6 +1444,8 @@ void call_impl( const ptx_instruction *pI, ptx_thread_info *thread )
 	   return;
    } else if( fname == "_Z10__wtcommitv" || fname == "__wtcommit" ) {
       // tcommitv_call(pI, thread);  // defer the commit so that it is warp-level 
+      if (thread->isInFunctionalSimulationMode()) 
+         tcommitv_call(pI, thread); // no warp-level commit outside of the timing model 
 	   return;
    } else if( fname == "_Z9__tcommiti" ) {
       // Intrinsic transaction commit call (do not automatically abort)
@@ -1418,6 +1468,8 @@ void call_impl( const ptx_instruction *pI, ptx_thread_info *thread )
       return; 
    } else if ( fname == "_Z12__wtrollbackv" || fname == "__wtrollback"  ) {
       // thread->get_tm_manager()->abort();  // defer the abort to apply to entire warp 
+      if (thread->isInFunctionalSimulationMode()) 
+         thread->get_tm_manager()->abort(); 
       return; 
    } else if ( fname == "_Z13__taccessmodei" ) {
       if (thread->get_tm_manager()) {
@@ -4531,7 +4583,7 @@ void inst_not_implemented( const ptx_instruction * pI )
    abort();
 }
 
-ptx_reg_t srcOperandModifiers(ptx_reg_t opData, operand_info opInfo, operand_info dstInfo, unsigned type, ptx_thread_info *thread)
+ptx_reg_t srcOperandModifiers(ptx_reg_t opData, const operand_info &opInfo, const operand_info &dstInfo, unsigned type, ptx_thread_info *thread)
 {
    ptx_reg_t result;
    memory_space *mem = NULL;
@@ -27,7 +27,9 @@
 
 #include "memory.h"
 #include <stdlib.h>
+#include <sys/mman.h>
 #include "../debug.h"
+#include "../gpgpu-sim/checkpoint.h"
 
 template<unsigned BSIZE> memory_space_impl<BSIZE>::memory_space_impl( std::string name, unsigned hash_size )
 {
@@ -153,11 +155,257 @@ template<unsigned BSIZE> void memory_space_impl<BSIZE>::set_watch( addr_t addr,
    m_watchpoints[watchpoint]=addr;
 }
 
+template<unsigned BSIZE> void memory_space_impl<BSIZE>::save_checkpoint( FILE *fp ) const
+{
+   ckpt_write_tag(fp, "mem"); 
+   ckpt_write(fp, BSIZE); 
+   size_t n_blocks = m_data.size(); 
+   ckpt_write(fp, n_blocks); 
+   unsigned char buffer[BSIZE]; 
+   typename map_t::const_iterator i_page;
+   for (i_page = m_data.begin(); i_page != m_data.end(); ++i_page) {
+      ckpt_write(fp, i_page->first); 
+      i_page->second.read(0, BSIZE, buffer); 
+      ckpt_write_raw(fp, buffer, BSIZE); 
+   }
+}
+
+template<unsigned BSIZE> void memory_space_impl<BSIZE>::load_checkpoint( FILE *fp ) 
+{
+   ckpt_check_tag(fp, "mem"); 
+   ckpt_check(fp, BSIZE, "memory block size"); 
+   size_t n_blocks; 
+   ckpt_read(fp, n_blocks); 
+   m_data.clear(); 
+   unsigned char buffer[BSIZE]; 
+   for (size_t b = 0; b < n_blocks; b++) {
+      mem_addr_t blk_idx; 
+      ckpt_read(fp, blk_idx); 
+      ckpt_read_raw(fp, buffer, BSIZE); 
+      m_data[blk_idx].write(0, BSIZE, buffer); 
+   }
+}
+
 template class memory_space_impl<32>;
 template class memory_space_impl<64>;
 template class memory_space_impl<8192>;
 template class memory_space_impl<16*1024>;
 
+paged_memory_space::paged_memory_space( std::string name )
+{
+   m_name = name;
+   memset(m_dir, 0, sizeof(m_dir));
+   m_chunk_pages_used = PAGES_PER_CHUNK;
+   m_n_pages = 0;
+   m_write_clock = 0;
+}
+
+paged_memory_space::~paged_memory_space()
+{
+   release_pages();
+}
+
+void paged_memory_space::release_pages()
+{
+   for( unsigned d=0; d < (1u << DIR_BITS); d++ ) {
+      delete m_dir[d];
+      m_dir[d] = NULL;
+   }
+   for( unsigned c=0; c < m_chunks.size(); c++ ) 
+      munmap(m_chunks[c], (size_t)PAGES_PER_CHUNK * PAGE_SIZE);
+   m_chunks.clear();
+   m_chunk_pages_used = PAGES_PER_CHUNK;
+   m_n_pages = 0;
+}
+
+unsigned char *paged_memory_space::get_page( mem_addr_t addr )
+{
+   page_table *&table = m_dir[addr >> (PAGE_BITS + TABLE_BITS)];
+   if( table == NULL ) {
+      table = new page_table;
+      memset(table, 0, sizeof(page_table));
+   }
+   unsigned char *&page = table->m_page[(addr >> PAGE_BITS) & ((1 << TABLE_BITS) - 1)];
+   if( page == NULL ) {
+      if( m_chunk_pages_used == PAGES_PER_CHUNK ) {
+         // anonymous mappings are zero filled and only become resident when touched 
+         void *chunk = mmap(NULL, (size_t)PAGES_PER_CHUNK * PAGE_SIZE, PROT_READ | PROT_WRITE, 
+                            MAP_PRIVATE | MAP_ANONYMOUS | MAP_NORESERVE, -1, 0);
+         if( chunk == MAP_FAILED ) {
+            printf("GPGPU-Sim PTX: ERROR ** failed to map %u KiB for memory \'%s\'\n", 
+                   (PAGES_PER_CHUNK * PAGE_SIZE) / 1024, m_name.c_str());
+            abort();
+         }
+         m_chunks.push_back((unsigned char*)chunk);
+         m_chunk_pages_used = 0;
+      }
+      page = m_chunks.back() + (size_t)m_chunk_pages_used * PAGE_SIZE;
+      m_chunk_pages_used++;
+      m_n_pages++;
+   }
+   return page;
+}
+
+// stamp the blocks covering [addr,addr+length) with a new write clock; their tables must exist 
+void paged_memory_space::update_version( mem_addr_t addr, size_t length )
+{
+   m_write_clock++;
+   size_t last = ((size_t)addr + length - 1) >> VERSION_BITS;
+   for( size_t b = addr >> VERSION_BITS; b <= last; b++ ) {
+      mem_addr_t block_addr = b << VERSION_BITS;
+      m_dir[block_addr >> (PAGE_BITS + TABLE_BITS)]->m_version[version_index(block_addr)] = m_write_clock;
+   }
+}
+
+bool paged_memory_space::unchanged_since( mem_addr_t addr, size_t length, unsigned long long clock ) const
+{
+   size_t last = ((size_t)addr + length - 1) >> VERSION_BITS;
+   for( size_t b = addr >> VERSION_BITS; b <= last; b++ ) {
+      mem_addr_t block_addr = b << VERSION_BITS;
+      const page_table *table = find_table(block_addr);
+      if( table != NULL && table->m_version[version_index(block_addr)] > clock ) 
+         return false;
+   }
+   return true;
+}
+
+void paged_memory_space::write( mem_addr_t addr, size_t length, const void *data, ptx_thread_info *thd, const ptx_instruction *pI )
+{
+   unsigned offset = addr & (PAGE_SIZE-1);
+   if( offset + length <= PAGE_SIZE ) {
+      // fast route for intra-page access, with the common word sizes copied inline 
+      unsigned char *page = get_page(addr);
+      switch( length ) {
+      case 4: memcpy(page+offset, data, 4); break;
+      case 8: memcpy(page+offset, data, 8); break;
+      default: memcpy(page+offset, data, length); break;
+      }
+   } else {
+      // slow route for inter-page access
+      size_t nbytes_remain = length;
+      size_t src_offset = 0; 
+      mem_addr_t current_addr = addr; 
+      while (nbytes_remain > 0) {
+         unsigned page_offset = current_addr & (PAGE_SIZE-1);
+         size_t tx_bytes = PAGE_SIZE - page_offset; 
+         if (tx_bytes > nbytes_remain) 
+            tx_bytes = nbytes_remain; 
+         memcpy(get_page(current_addr)+page_offset, &((const unsigned char*)data)[src_offset], tx_bytes);
+         src_offset += tx_bytes; 
+         current_addr += tx_bytes; 
+         nbytes_remain -= tx_bytes; 
+      }
+   }
+   if( length > 0 ) 
+      update_version(addr, length);
+   if( !m_watchpoints.empty() ) {
+      std::map<unsigned,mem_addr_t>::iterator i;
+      for( i=m_watchpoints.begin(); i!=m_watchpoints.end(); i++ ) {
+         mem_addr_t wa = i->second;
+         if( ((addr<=wa) && ((addr+length)>wa)) || ((addr>wa) && (addr < (wa+4))) ) 
+            hit_watchpoint(i->first,thd,pI);
+      }
+   }
+}
+
+void paged_memory_space::read( mem_addr_t addr, size_t length, void *data ) const
+{
+   unsigned offset = addr & (PAGE_SIZE-1);
+   if( offset + length <= PAGE_SIZE ) {
+      // fast route for intra-page access, with the common word sizes copied inline 
+      const unsigned char *page = find_page(addr);
+      if( page == NULL ) {
+         memset(data, 0, length);
+         return;
+      }
+      switch( length ) {
+      case 4: memcpy(data, page+offset, 4); break;
+      case 8: memcpy(data, page+offset, 8); break;
+      default: memcpy(data, page+offset, length); break;
+      }
+   } else {
+      // slow route for inter-page access
+      size_t nbytes_remain = length;
+      size_t dst_offset = 0; 
+      mem_addr_t current_addr = addr; 
+      while (nbytes_remain > 0) {
+         unsigned page_offset = current_addr & (PAGE_SIZE-1);
+         size_t tx_bytes = PAGE_SIZE - page_offset; 
+         if (tx_bytes > nbytes_remain) 
+            tx_bytes = nbytes_remain; 
+         const unsigned char *page = find_page(current_addr);
+         unsigned char *dst = &((unsigned char*)data)[dst_offset];
+         if( page == NULL ) 
+            memset(dst, 0, tx_bytes);
+         else 
+            memcpy(dst, page+page_offset, tx_bytes);
+         dst_offset += tx_bytes; 
+         current_addr += tx_bytes; 
+         nbytes_remain -= tx_bytes; 
+      }
+   }
+}
+
+void paged_memory_space::print( const char *format, FILE *fout ) const
+{
+   for( unsigned d=0; d < (1u << DIR_BITS); d++ ) {
+      if( m_dir[d] == NULL ) 
+         continue;
+      for( unsigned p=0; p < (1u << TABLE_BITS); p++ ) {
+         const unsigned *i_data = (const unsigned*)m_dir[d]->m_page[p];
+         if( i_data == NULL ) 
+            continue;
+         fprintf(fout, "%s - %#x:", m_name.c_str(), (d << (PAGE_BITS + TABLE_BITS)) | (p << PAGE_BITS));
+         for( unsigned w = 0; w < PAGE_SIZE / sizeof(unsigned); w++ ) {
+            if (w % 8 == 0) 
+               fprintf(fout, "\n");
+            fprintf(fout, format, i_data[w]);
+            fprintf(fout, " ");
+         }
+         fprintf(fout, "\n");
+      }
+   }
+   fflush(fout);
+}
+
+void paged_memory_space::set_watch( addr_t addr, unsigned watchpoint ) 
+{
+   m_watchpoints[watchpoint]=addr;
+}
+
+void paged_memory_space::save_checkpoint( FILE *fp ) const
+{
+   ckpt_write_tag(fp, "pmem"); 
+   ckpt_write(fp, (unsigned)PAGE_SIZE); 
+   ckpt_write(fp, m_n_pages); 
+   for( unsigned d=0; d < (1u << DIR_BITS); d++ ) {
+      if( m_dir[d] == NULL ) 
+         continue;
+      for( unsigned p=0; p < (1u << TABLE_BITS); p++ ) {
+         if( m_dir[d]->m_page[p] == NULL ) 
+            continue;
+         mem_addr_t page_addr = (d << (PAGE_BITS + TABLE_BITS)) | (p << PAGE_BITS);
+         ckpt_write(fp, page_addr); 
+         ckpt_write_raw(fp, m_dir[d]->m_page[p], PAGE_SIZE); 
+      }
+   }
+}
+
+void paged_memory_space::load_checkpoint( FILE *fp ) 
+{
+   ckpt_check_tag(fp, "pmem"); 
+   ckpt_check(fp, (unsigned)PAGE_SIZE, "memory page size"); 
+   size_t n_pages; 
+   ckpt_read(fp, n_pages); 
+   release_pages(); 
+   for( size_t n = 0; n < n_pages; n++ ) {
+      mem_addr_t page_addr; 
+      ckpt_read(fp, page_addr); 
+      ckpt_read_raw(fp, get_page(page_addr), PAGE_SIZE); 
+      update_version(page_addr, PAGE_SIZE); 
+   }
+}
+
 void g_print_memory_space(memory_space *mem, const char *format = "%08x", FILE *fout = stdout) 
 {
     mem->print(format,fout);
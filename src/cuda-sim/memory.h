@@ -43,6 +43,7 @@
 #include <stdio.h>
 #include <string>
 #include <map>
+#include <vector>
 #include <stdlib.h>
 
 typedef address_type mem_addr_t;
@@ -107,6 +108,16 @@ public:
    virtual void read( mem_addr_t addr, size_t length, void *data ) const = 0;
    virtual void print( const char *format, FILE *fout ) const = 0;
    virtual void set_watch( addr_t addr, unsigned watchpoint ) = 0;
+
+   // checkpoint of the whole address space (replaces the current content on load)
+   virtual void save_checkpoint( FILE *fp ) const = 0;
+   virtual void load_checkpoint( FILE *fp ) = 0;
+
+   // write versioning, so that values read earlier can be revalidated without reading them again: 
+   // unchanged_since() is true if [addr,addr+length) has not been written after write_clock() 
+   // returned clock. Spaces without versioning never report data as unchanged. 
+   virtual unsigned long long write_clock() const { return 0; }
+   virtual bool unchanged_since( mem_addr_t addr, size_t length, unsigned long long clock ) const { return false; }
 };
 
 template<unsigned BSIZE> class memory_space_impl : public memory_space {
@@ -118,6 +129,9 @@ public:
    virtual void print( const char *format, FILE *fout ) const;
    virtual void set_watch( addr_t addr, unsigned watchpoint ); 
 
+   virtual void save_checkpoint( FILE *fp ) const;
+   virtual void load_checkpoint( FILE *fp );
+
 private:
    void read_single_block( mem_addr_t blk_idx, mem_addr_t addr, size_t length, void *data) const; 
    std::string m_name;
@@ -127,4 +141,61 @@ private:
    std::map<unsigned,mem_addr_t> m_watchpoints;
 };
 
+// Memory space backed by a two-level page table of large (64 KiB) pages. Pages are carved out 
+// of anonymous mmap'd chunks on their first write, so the untouched parts of large device 
+// allocations take no host memory, and reads from them return zero. Each 1 KiB block records the 
+// write clock of its last write (see memory_space::unchanged_since). 
+class paged_memory_space : public memory_space {
+public:
+   paged_memory_space( std::string name );
+   virtual ~paged_memory_space();
+
+   virtual void write( mem_addr_t addr, size_t length, const void *data, ptx_thread_info *thd, const ptx_instruction *pI );
+   virtual void read( mem_addr_t addr, size_t length, void *data ) const;
+   virtual void print( const char *format, FILE *fout ) const;
+   virtual void set_watch( addr_t addr, unsigned watchpoint ); 
+
+   virtual void save_checkpoint( FILE *fp ) const;
+   virtual void load_checkpoint( FILE *fp );
+
+   virtual unsigned long long write_clock() const { return m_write_clock; }
+   virtual bool unchanged_since( mem_addr_t addr, size_t length, unsigned long long clock ) const;
+
+private:
+   enum {
+      PAGE_BITS = 16,
+      PAGE_SIZE = 1 << PAGE_BITS,
+      TABLE_BITS = 8, // pages per second level table: 256 (16 MiB) 
+      DIR_BITS = 32 - PAGE_BITS - TABLE_BITS,
+      VERSION_BITS = 10, // write versioning granularity: 1 KiB 
+      PAGES_PER_CHUNK = 64 // pages per mmap'd chunk: 4 MiB 
+   };
+   struct page_table {
+      unsigned char *m_page[1 << TABLE_BITS];
+      unsigned long long m_version[1 << (TABLE_BITS + PAGE_BITS - VERSION_BITS)];
+   };
+
+   const page_table *find_table( mem_addr_t addr ) const { return m_dir[addr >> (PAGE_BITS + TABLE_BITS)]; }
+   unsigned char *find_page( mem_addr_t addr ) const
+   {
+      const page_table *table = find_table(addr);
+      return table? table->m_page[(addr >> PAGE_BITS) & ((1 << TABLE_BITS) - 1)] : NULL;
+   }
+   static unsigned version_index( mem_addr_t addr ) 
+   { 
+      return (addr >> VERSION_BITS) & ((1 << (TABLE_BITS + PAGE_BITS - VERSION_BITS)) - 1); 
+   }
+   unsigned char *get_page( mem_addr_t addr );
+   void update_version( mem_addr_t addr, size_t length );
+   void release_pages();
+
+   std::string m_name;
+   page_table *m_dir[1 << DIR_BITS];
+   unsigned long long m_write_clock; // number of writes so far 
+   std::vector<unsigned char*> m_chunks;
+   unsigned m_chunk_pages_used; // pages handed out from the last chunk 
+   size_t m_n_pages;
+   std::map<unsigned,mem_addr_t> m_watchpoints;
+};
+
 #endif
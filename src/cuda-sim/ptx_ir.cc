@@ -1030,6 +1030,9 @@ ptx_instruction::ptx_instruction( int opcode,
    m_uid = ++g_num_ptx_inst_uid;
    m_PC = 0;
    m_opcode = opcode;
+   m_exec_impl = NULL;
+   m_op_classification = 0;
+   m_warp_alu = WARP_ALU_NONE;
    m_pred = pred;
    m_neg_pred = neg_pred;
    m_pred_mod = pred_mod;
@@ -1279,6 +1282,7 @@ function_info::function_info(int entry_point )
    m_kernel_info.regs = 0;
    m_kernel_info.smem = 0;
    m_local_mem_framesize = 0;
+   m_num_reg_slots = 0;
 }
 
 unsigned function_info::print_insn( unsigned pc, FILE * fp ) const
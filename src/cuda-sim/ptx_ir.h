@@ -167,6 +167,7 @@ public:
       m_is_param_local = false;
       m_is_tex = false;
       m_is_func_addr = false;
+      m_is_underscore = (m_name == "_");
       m_reg_num_valid = false;
       m_function = NULL;
       m_reg_num=(unsigned)-1;
@@ -244,7 +245,7 @@ public:
        }
       return m_type->get_key().is_non_arch_reg(); 
    }
-   bool is_underscore() const { return (m_name == "_"); } // for a null dst reg in call return 
+   bool is_underscore() const { return m_is_underscore; } // for a null dst reg in call return 
 
    void add_initializer( const std::list<operand_info> &init );
    bool has_initializer() const 
@@ -265,6 +266,11 @@ public:
       assert( m_reg_num_valid );
       return m_arch_reg_num; 
    }
+   // index of this register in its function's register frame, (unsigned)-1 if not a register 
+   unsigned reg_slot() const 
+   {
+      return m_reg_num_valid? m_reg_num : (unsigned)-1; 
+   }
    void print_info(FILE *fp) const;
    unsigned uid() const { return m_uid; }
 
@@ -288,6 +294,7 @@ private:
    bool m_is_param_local;
    bool m_is_tex;
    bool m_is_func_addr;
+   bool m_is_underscore;
    unsigned m_reg_num; 
    unsigned m_arch_reg_num; 
    bool m_reg_num_valid; 
@@ -315,6 +322,7 @@ public:
    type_info *get_array_type( type_info *base_type, unsigned array_dim ); 
    void set_label_address( const symbol *label, unsigned addr );
    unsigned next_reg_num() { return ++m_reg_allocator;}
+   unsigned num_reg_slots() const { return m_reg_allocator + 1; } // register numbers handed out so far, plus "_" 
    addr_t get_shared_next() { return m_shared_next;}
    addr_t get_global_next() { return m_global_next;}
    addr_t get_local_next() { return m_local_next;}
@@ -1010,6 +1018,23 @@ public:
 
    int membar_level() const { return m_membar_level; }
 
+   // functional model handler and op classification of this opcode, resolved by pre_decode() 
+   typedef void (*exec_impl_t)( const ptx_instruction *pI, class ptx_thread_info *thread );
+   exec_impl_t get_exec_impl() const { return m_exec_impl; }
+   int get_op_classification() const { return m_op_classification; }
+
+   // register/literal-only ALU forms that a warp can execute for all of its lanes at once 
+   // (see ptx_thread_info::ptx_exec_warp_inst), resolved by pre_decode() 
+   enum warp_alu_t { 
+      WARP_ALU_NONE = 0, 
+      WARP_ALU_MOV, 
+      WARP_ALU_ADD32, WARP_ALU_ADD64, WARP_ALU_ADDF32, 
+      WARP_ALU_SUB32, WARP_ALU_SUB64, WARP_ALU_SUBF32, 
+      WARP_ALU_AND, WARP_ALU_OR, WARP_ALU_XOR, 
+      WARP_ALU_SETP 
+   };
+   warp_alu_t get_warp_alu() const { return m_warp_alu; }
+
    bool has_memory_read() const {
       if( m_opcode == LD_OP || m_opcode == LDU_OP || m_opcode == TEX_OP ) 
          return true;
@@ -1077,7 +1102,11 @@ private:
    int m_membar_level;
    int m_instr_mem_index; //index into m_instr_mem array
    unsigned m_inst_size; // bytes
+   exec_impl_t m_exec_impl; 
+   int m_op_classification; 
+   warp_alu_t m_warp_alu; 
 
+   warp_alu_t decode_warp_alu() const;
    virtual void pre_decode();
    friend class function_info;
    static unsigned g_num_ptx_inst_uid;
@@ -1268,11 +1297,13 @@ public:
    {
       m_local_mem_framesize = sz;
    }
+   unsigned num_reg_slots() const { return m_num_reg_slots; } // size of a register frame of this function 
    bool is_entry_point() const { return m_entry_point; }
 
 private:
    unsigned m_uid;
    unsigned m_local_mem_framesize;
+   unsigned m_num_reg_slots;
    bool m_entry_point;
    bool m_extern;
    bool m_assembled;
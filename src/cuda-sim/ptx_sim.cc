@@ -163,7 +163,7 @@ ptx_thread_info::ptx_thread_info( kernel_info_t &kernel )
    m_hw_sid = -1;
    m_last_dram_callback.function = NULL;
    m_last_dram_callback.instruction = NULL;
-   m_regs.push_back( reg_map_t() );
+   m_regs.push_back( ptx_reg_frame() );
    m_debug_trace_regs_modified.push_back( reg_map_t() );
    m_debug_trace_regs_read.push_back( reg_map_t() );
    m_callstack.push_back( stack_entry() );
@@ -293,6 +293,7 @@ void ptx_thread_info::set_info( function_info *func )
   m_symbol_table = func->get_symtab();
   m_func_info = func;
   m_PC = func->get_start_PC();
+  m_regs.back().reserve_slots( func->num_reg_slots() );
 }
 
 void ptx_thread_info::cpy_tid_to_reg( dim3 tid )
@@ -373,7 +374,7 @@ void ptx_thread_info::callstack_push( unsigned pc, unsigned rpc, const symbol *r
 	   m_tm_reg_states.push_back(tm_reg_state_map_t());
    }
    m_callstack.push_back( stack_entry(m_symbol_table,m_func_info,pc,rpc,return_var_src,return_var_dst,call_uid,is_tm) );
-   m_regs.push_back( reg_map_t() );
+   m_regs.push_back( ptx_reg_frame() );
    m_debug_trace_regs_modified.push_back( reg_map_t() );
    m_debug_trace_regs_read.push_back( reg_map_t() );
    m_local_mem_stack_pointer += m_func_info->local_mem_framesize(); 
@@ -472,13 +473,13 @@ bool ptx_thread_info::callstack_pop_plus()
 void ptx_thread_info::dump_callstack() const
 {
    std::vector<stack_entry>::const_iterator c=m_callstack.begin();
-   std::list<reg_map_t>::const_iterator r=m_regs.begin();
+   std::list<ptx_reg_frame>::const_iterator r=m_regs.begin();
 
    printf("\n\n");
    printf("Call stack for thread uid = %u (sc=%u, hwtid=%u)\n", m_uid, m_hw_sid, m_hw_tid );
    while( c != m_callstack.end() && r != m_regs.end() ) {
       const stack_entry &c_e = *c;
-      const reg_map_t &regs = *r;
+      const ptx_reg_frame &regs = *r;
       if( !c_e.m_valid ) {
          printf("  <entry>                              #regs = %zu\n", regs.size() );
       } else {
@@ -521,13 +522,18 @@ void ptx_thread_info::dump_regs( FILE *fp )
    if(m_regs.back().empty()) return;
    fprintf(fp,"Register File Contents:\n");
    fflush(fp);
-   reg_map_t::const_iterator r;
-   for ( r=m_regs.back().begin(); r != m_regs.back().end(); ++r ) {
-      const symbol *sym = r->first;
-      ptx_reg_t value = r->second;
-      std::string name = sym->name();
-      print_reg(fp,name,value,m_symbol_table);
+   m_regs.back().print(fp,m_symbol_table);
+}
+
+void ptx_reg_frame::print( FILE *fp, symbol_table *symtab ) const
+{
+   for ( unsigned slot=0; slot < m_syms.size(); ++slot ) {
+      if ( m_syms[slot] == NULL ) continue;
+      print_reg(fp,m_syms[slot]->name(),m_values[slot],symtab);
    }
+   tr1_hash_map<const symbol*,ptx_reg_t>::const_iterator r;
+   for ( r=m_spill.begin(); r != m_spill.end(); ++r ) 
+      print_reg(fp,r->first->name(),r->second,symtab);
 }
 
 void ptx_thread_info::dump_modifiedregs(FILE *fp)
@@ -579,6 +585,7 @@ void ptx_thread_info::set_npc( const function_info *f )
    m_NPC = f->get_start_PC();
    m_func_info = const_cast<function_info*>( f );
    m_symbol_table = m_func_info->get_symtab();
+   m_regs.back().reserve_slots( f->num_reg_slots() );
 }
 
 void ptx_thread_info::tx_begin( const ptx_instruction *pI, bool timing_mode ) {
@@ -39,6 +39,7 @@
 #include <map>
 #include <set>
 #include <list>
+#include <vector>
 
 #include "memory.h"
 #include "tm_manager.h"
@@ -269,6 +270,28 @@ enum tm_reg_state {
    REGSTATE_N_TM_REG_STATES    // counting purposes only
 };
 
+// Registers of one call frame, indexed by the register number the parser gives each register 
+// symbol of a function (symbol::reg_slot()). The frame is a flat array, so that a register 
+// access is an index and a TM checkpoint of the register file is a copy of a few vectors. A 
+// slot with a NULL symbol has not been written. A register whose slot is taken by another 
+// symbol (ptxplus calls share the caller's frame) goes to a small side map. 
+class ptx_reg_frame {
+public:
+   ptx_reg_frame() : m_n_defined(0) {}
+   ptx_reg_t* find( const symbol *reg ); // NULL if the register has not been written 
+   void set( const symbol *reg, const ptx_reg_t &value ); 
+   ptx_reg_t& operator[]( const symbol *reg ); // inserts a zero value if not written yet 
+   void reserve_slots( unsigned n_slots ); 
+   size_t size() const { return m_n_defined; } // number of written registers 
+   bool empty() const { return m_n_defined == 0; }
+   void print( FILE *fp, symbol_table *symtab ) const; 
+private:
+   std::vector<const symbol*> m_syms; 
+   std::vector<ptx_reg_t> m_values; 
+   tr1_hash_map<const symbol*,ptx_reg_t> m_spill; 
+   size_t m_n_defined; 
+};
+
 class tm_manager; 
 class ptx_thread_info {
 public:
@@ -293,11 +316,12 @@ public:
 
    void ptx_fetch_inst( inst_t &inst ) const;
    void ptx_exec_inst( warp_inst_t &inst, unsigned lane_id );
+   static bool ptx_exec_warp_inst( warp_inst_t &inst, ptx_thread_info **threads, unsigned warp_size );
 
    const ptx_version &get_ptx_version() const;
    void set_reg( const symbol *reg, const ptx_reg_t &value );
    ptx_reg_t get_reg( const symbol *reg );
-   ptx_reg_t get_operand_value( const operand_info &op, operand_info dstInfo, unsigned opType, ptx_thread_info *thread, int derefFlag );
+   ptx_reg_t get_operand_value( const operand_info &op, const operand_info &dstInfo, unsigned opType, ptx_thread_info *thread, int derefFlag );
    void set_operand_value( const operand_info &dst, const ptx_reg_t &data, unsigned type, ptx_thread_info *thread, const ptx_instruction *pI );
    void set_operand_value( const operand_info &dst, const ptx_reg_t &data, unsigned type, ptx_thread_info *thread, const ptx_instruction *pI, int overflow, int carry );
    void get_vector_operand_values( const operand_info &op, ptx_reg_t* ptx_regs, unsigned num_elements );
@@ -465,6 +489,7 @@ public:
    unsigned m_debug_thread_id;
 
 private:
+   void ptx_exec_inst_retire( warp_inst_t &inst, unsigned lane_id, const ptx_instruction *pI, addr_t pc, bool skip, int op_classification );
 
    bool m_functionalSimulationMode; 
    unsigned m_uid;
@@ -502,7 +527,7 @@ private:
 
    typedef tr1_hash_map<const symbol*,ptx_reg_t> reg_map_t;
    typedef tr1_hash_map<const symbol*,tm_reg_state> tm_reg_state_map_t;
-   std::list<reg_map_t> m_regs;
+   std::list<ptx_reg_frame> m_regs;
    std::list<tm_reg_state_map_t> m_tm_reg_states;
 
    std::list<reg_map_t> m_debug_trace_regs_modified;
@@ -521,7 +546,7 @@ private:
 
 	unsigned m_tm_restart_PC;
 	int m_tm_stack_count;
-   std::list<reg_map_t> m_tm_regs_snapshot;
+   std::list<ptx_reg_frame> m_tm_regs_snapshot;
    std::list<reg_map_t> m_tm_debug_trace_regs_modified_snapshot;
    std::list<reg_map_t> m_tm_debug_trace_regs_read_snapshot;
 
@@ -13,6 +13,7 @@
 #include "tm_manager_internal.h"
 #include "../gpgpu-sim/gpu-sim.h"
 #include "../gpgpu-sim/l2cache.h"
+#include "../gpgpu-sim/checkpoint.h"
 
 extern unsigned long long gpu_sim_cycle; // for data collection ><
 extern unsigned long long gpu_tot_sim_cycle; // for data collection ><
@@ -99,6 +100,11 @@ tm_manager::tm_manager(	ptx_thread_info *thread, bool timing_mode )
    m_n_write = 0; 
    m_n_rewrite = 0;
    m_gmem_view_tx = NULL; 
+   m_tx_pc = 0; 
+   m_first_start_cycle = 0; 
+   m_abort_cause = TM_ABORT_OTHER; 
+   m_abort_addr = 0; 
+   m_abort_pc = 0; 
 }
 
 tm_manager::~tm_manager()
@@ -115,6 +121,8 @@ void tm_manager::start()
 	m_thread->start_transaction(this);
 	m_nesting_level = 1;
         m_start_cycle = gpu_sim_cycle; 
+        m_first_start_cycle = gpu_sim_cycle; 
+        m_tx_pc = m_thread->get_pc(); 
 	g_tm_global_statistics.m_n_transactions += 1; 
 	g_tm_global_statistics.inc_concurrency();
 
@@ -183,25 +191,50 @@ void ring_tm_manager::ring_tm_access(addr_t addr, int nbytes, bool rd)
    }
 }
 
+tm_manager::tm_mem_bucket* tm_manager::tm_mem_t::find( memory_space *mem, unsigned bucket_addr )
+{
+   entry key; 
+   key.m_mem = mem; 
+   key.m_bucket_addr = bucket_addr; 
+   std::vector<entry>::iterator i = std::lower_bound(m_entries.begin(), m_entries.end(), key); 
+   if (i != m_entries.end() && i->m_mem == mem && i->m_bucket_addr == bucket_addr) 
+      return &(i->m_bucket); 
+   return NULL; 
+}
+
+tm_manager::tm_mem_bucket& tm_manager::tm_mem_t::lookup_or_insert( memory_space *mem, unsigned bucket_addr )
+{
+   entry key; 
+   key.m_mem = mem; 
+   key.m_bucket_addr = bucket_addr; 
+   std::vector<entry>::iterator i = std::lower_bound(m_entries.begin(), m_entries.end(), key); 
+   if (i == m_entries.end() || i->m_mem != mem || i->m_bucket_addr != bucket_addr) 
+      i = m_entries.insert(i, key); 
+   return i->m_bucket; 
+}
+
+// block granularity read/write sets, only needed for statistics at commit 
+void tm_manager::derive_block_sets() 
+{
+   unsigned block_size_log2 = g_tm_options.m_access_block_size_log2; 
+   m_read_block_set.assign_coarser(m_read_set, block_size_log2); 
+   m_write_block_set.assign_coarser(m_write_set, block_size_log2); 
+   m_access_block_set.assign_union(m_read_block_set, m_write_block_set); 
+}
+
 // update read/write sets in different granularities 
 void tm_manager::update_access_sets(addr_t addr, unsigned nbytes, bool rd, bool detect_conflict) 
 {
    unsigned word_size_log2 = g_tm_options.m_word_size_log2; 
-   unsigned block_size_log2 = g_tm_options.m_access_block_size_log2; 
    for( unsigned a=addr; a < addr+nbytes; ++a ) {
       addr_t word_addr = a >> word_size_log2; 
-      addr_t block_addr = a >> block_size_log2; 
       if (detect_conflict) {
-         m_access_word_set.insert(word_addr); 
-         m_access_block_set.insert(block_addr); 
          if( rd ) {
             m_read_set.insert(a);
             m_read_word_set.insert(word_addr); 
-            m_read_block_set.insert(block_addr); 
          } else {
             m_write_set.insert(a);
             m_write_word_set.insert(word_addr); 
-            m_write_block_set.insert(block_addr); 
             if (m_gmem_view_tx != NULL) {
                m_gmem_view_tx->m_warp_level_write_word_set.insert(word_addr); 
             }
@@ -296,26 +329,21 @@ void tm_manager::set_tm_raw_info(addr_t addr, memory_space *mem, memory_space_t
    if (m_gmem_view_tx != NULL and space == global_space) {
       spec_mem = &(m_gmem_view_tx->m_tm_mem); 
    }
-   tm_mem_t::iterator i = spec_mem->find(mem);
-   if( i != spec_mem->end() ) {
-      // we have written to this memory space
-      tm_mem_hash_t &hash = i->second;
-      tm_mem_hash_t::iterator i = hash.find(addr>>TM_MEM_BUCKET_SIZE);
-      if( i != hash.end() ) {
-         // we have written to a location close to this address
-         tm_mem_bucket &bucket = i->second;
-         unsigned a = (addr&((1<<TM_MEM_BUCKET_SIZE)-1));
+   tm_mem_bucket *written_bucket = spec_mem->find(mem, addr>>TM_MEM_BUCKET_SIZE);
+   if( written_bucket != NULL ) {
+      // we have written to a location close to this address
+      tm_mem_bucket &bucket = *written_bucket;
+      unsigned a = (addr&((1<<TM_MEM_BUCKET_SIZE)-1));
 
-         assert( (1<<TM_MEM_BUCKET_SIZE) == 8 * sizeof(unsigned long long) ); // code below expects this
-         unsigned long mask = ((unsigned long long)1)<<a;
-         assert((a + nbytes-1)<(1<<TM_MEM_BUCKET_SIZE)); // Make sure the data being written doesnt exceed bucket size
-         for( unsigned n=0; n < nbytes; ++n, mask <<= 1 ) {
-            if( (bucket.m_modified & mask) != 0 ) {
-               m_raw_set.insert(a + n); // record that this bit is read after written 
-               m_raw_access++;
-               tx_raw_access = true; 
-	    }
-	 }
+      assert( (1<<TM_MEM_BUCKET_SIZE) == 8 * sizeof(unsigned long long) ); // code below expects this
+      unsigned long mask = ((unsigned long long)1)<<a;
+      assert((a + nbytes-1)<(1<<TM_MEM_BUCKET_SIZE)); // Make sure the data being written doesnt exceed bucket size
+      for( unsigned n=0; n < nbytes; ++n, mask <<= 1 ) {
+         if( (bucket.m_modified & mask) != 0 ) {
+            m_raw_set.insert(a + n); // record that this bit is read after written 
+            m_raw_access++;
+            tx_raw_access = true; 
+         }
       }
    }
    if (tx_raw_access) {
@@ -400,35 +428,29 @@ bool tm_manager::tm_access( memory_space *mem, memory_space_t space, bool rd, ad
    }
    if( rd ) {
       bool tx_raw_access = false; 
-      tm_mem_t::iterator i = spec_mem->find(mem);
-      if( i != spec_mem->end() ) {
-         // we have written to this memory space
-	 tm_mem_hash_t &hash = i->second;
-	 tm_mem_hash_t::iterator i = hash.find(addr>>TM_MEM_BUCKET_SIZE);
-	 if( i != hash.end() ) {
-	    // we have written to a location close to this address
-	    tm_mem_bucket &bucket = i->second;
-	    unsigned a = (addr&((1<<TM_MEM_BUCKET_SIZE)-1));
-
-	    assert( (1<<TM_MEM_BUCKET_SIZE) == 8 * sizeof(unsigned long long) ); // code below expects this
-	    unsigned long mask = ((unsigned long long)1)<<a;
-	    assert((a + nbytes-1)<(1<<TM_MEM_BUCKET_SIZE)); // Make sure the data being written doesnt exceed bucket size
-	    for( unsigned n=0; n < nbytes; ++n, mask <<= 1 ) {
-	       if( (bucket.m_modified & mask) != 0 ) {
-	       	  ((unsigned char*)vp)[n] = bucket.m_data[a + n];
-                  if (potential_conflicting && g_tm_options.m_use_logical_timestamp_based_tm == false) {
-                     m_raw_set.insert(a + n); // record that this bit is read after written 
-                     m_raw_access++;
-                     tx_raw_access = true; 
-                  }
-	       } else {
-		  mem->read(addr + n, 1, ((char*)vp)+n);
+      tm_mem_bucket *written_bucket = spec_mem->find(mem, addr>>TM_MEM_BUCKET_SIZE);
+      if( written_bucket != NULL ) {
+         // we have written to a location close to this address
+         tm_mem_bucket &bucket = *written_bucket;
+         unsigned a = (addr&((1<<TM_MEM_BUCKET_SIZE)-1));
+
+         assert( (1<<TM_MEM_BUCKET_SIZE) == 8 * sizeof(unsigned long long) ); // code below expects this
+         unsigned long mask = ((unsigned long long)1)<<a;
+         assert((a + nbytes-1)<(1<<TM_MEM_BUCKET_SIZE)); // Make sure the data being written doesnt exceed bucket size
+         for( unsigned n=0; n < nbytes; ++n, mask <<= 1 ) {
+            if( (bucket.m_modified & mask) != 0 ) {
+               ((unsigned char*)vp)[n] = bucket.m_data[a + n];
+               if (potential_conflicting && g_tm_options.m_use_logical_timestamp_based_tm == false) {
+                  m_raw_set.insert(a + n); // record that this bit is read after written 
+                  m_raw_access++;
+                  tx_raw_access = true; 
                }
-	    }
-	 } else
-	    mem->read(addr, nbytes, vp);
+            } else {
+               mem->read(addr + n, 1, ((char*)vp)+n);
+            }
+         }
       } else 
-	 mem->read(addr, nbytes, vp);
+         mem->read(addr, nbytes, vp);
       if (tx_raw_access) {
          uarch_info.m_writelog_access.set(m_thread_hwtid % tm_access_uarch_info::warp_size); 
       }
@@ -437,7 +459,7 @@ bool tm_manager::tm_access( memory_space *mem, memory_space_t space, bool rd, ad
                 addr, *((unsigned int*)vp));
       }
    } else {
-      tm_mem_bucket &bucket = (*spec_mem)[mem][addr>>TM_MEM_BUCKET_SIZE];
+      tm_mem_bucket &bucket = spec_mem->lookup_or_insert(mem, addr>>TM_MEM_BUCKET_SIZE);
       unsigned a = (addr&((1<<TM_MEM_BUCKET_SIZE)-1));
       unsigned long mask = ((unsigned long long)1)<<a;
       assert((a + nbytes-1)<(1<<TM_MEM_BUCKET_SIZE));// Make sure the data being written doesnt exceed bucket size
@@ -475,7 +497,9 @@ void tm_manager::abort()
 {
    at_abort(); 
    g_tm_global_statistics.m_n_aborts += 1;
-   g_tm_global_statistics.record_abort_tx_size(m_read_word_set.size(), m_write_word_set.size(), m_access_word_set.size()); 
+   g_tm_global_statistics.record_tx_profile_abort(m_tx_pc, m_abort_cause, m_abort_addr, m_abort_pc); 
+   m_abort_cause = TM_ABORT_OTHER; 
+   g_tm_global_statistics.record_abort_tx_size(m_read_word_set.size(), m_write_word_set.size(), access_word_count()); 
    g_tm_global_statistics.record_raw_info(m_raw_set.size(), m_raw_access); 
 
    m_stats.m_abort =1;
@@ -486,7 +510,6 @@ void tm_manager::abort()
    m_write_set.clear();
    m_read_word_set.clear(); 
    m_write_word_set.clear(); 
-   m_access_word_set.clear(); 
    m_read_block_set.clear(); 
    m_write_block_set.clear(); 
    m_access_block_set.clear(); 
@@ -528,6 +551,26 @@ void tm_manager::abort()
 #endif
 }
 
+// keep the first conflict seen by this attempt, it is reported when the transaction aborts 
+void tm_manager::set_abort_cause(enum tm_abort_cause_t cause, addr_t addr, address_type pc)
+{
+   if (m_abort_cause != TM_ABORT_OTHER) return; 
+   m_abort_cause = cause; 
+   m_abort_addr = addr; 
+   m_abort_pc = pc; 
+}
+
+// pc of the youngest buffered store covering addr 
+address_type tm_manager::get_write_pc( addr_t addr ) const
+{
+   std::list<access_record>::const_reverse_iterator i; 
+   for (i = m_write_data.rbegin(); i != m_write_data.rend(); ++i) {
+      if (i->contain_addr(addr, 1)) 
+         return i->get_pc(); 
+   }
+   return 0; 
+}
+
 void tm_manager::add_rollback_insn( unsigned insn_count )
 {
    g_tm_global_statistics.m_n_rollback_insn += insn_count;
@@ -586,6 +629,17 @@ void tm_manager::committer_win_conflict_resolution()
             // thread ct is still in a transaction...
             tm_manager *ct_tm = dynamic_cast<tm_manager*>( ct->get_tm_manager() );
             assert( ct_tm != NULL );
+            if (g_tm_options.m_tx_profile) {
+               // attribute the abort to the first committed word the victim has accessed 
+               addr_t word_size_log2 = g_tm_options.m_word_size_log2; 
+               for (addr_set_t::const_iterator w = m_write_word_set.begin(); w != m_write_word_set.end(); ++w) {
+                  if (ct_tm->m_read_word_set.count(*w) or ct_tm->m_write_word_set.count(*w)) {
+                     ct_tm->set_abort_cause(TM_ABORT_COMMITTER_WIN, *w << word_size_log2, get_write_pc(*w << word_size_log2)); 
+                     break; 
+                  }
+               }
+            }
+            ct_tm->set_abort_cause(TM_ABORT_COMMITTER_WIN, 0, m_tx_pc); 
             ct_tm->abort();
          }
       }
@@ -674,6 +728,11 @@ bool tm_manager::commit(bool auto_self_abort)
        access_record &w = *i;
        w.commit();
        writing_tx = true; 
+       // warm up the timestamps seen by the timing model 
+       if (!m_timing_mode and g_tm_options.m_functional_warmup_temporal_cd and w.get_memory_space() == m_thread->get_global_memory()) {
+          addr_t waddr = w.getaddr() >> g_tm_options.m_word_size_log2; 
+          temporal_conflict_detector::get_singleton().update_word( waddr, gpu_sim_cycle + gpu_tot_sim_cycle ); 
+       }
    }
 
    m_thread->tm_commit();
@@ -690,10 +749,12 @@ bool tm_manager::commit(bool auto_self_abort)
 	g_tm_global_statistics.m_n_commits += 1;
    if (writing_tx) g_tm_global_statistics.m_n_writing_commits += 1;
 	g_tm_global_statistics.dec_concurrency();
-   g_tm_global_statistics.record_commit_tx_size(m_read_word_set.size(), m_write_word_set.size(), m_access_word_set.size());
+   g_tm_global_statistics.record_commit_tx_size(m_read_word_set.size(), m_write_word_set.size(), access_word_count());
+   derive_block_sets(); 
    g_tm_global_statistics.record_tx_blockcount(m_read_block_set, m_write_block_set, m_access_block_set); 
    g_tm_global_statistics.record_raw_info(m_raw_set.size(), m_raw_access); 
    g_tm_global_statistics.m_aborts_per_transaction.add2bin(m_abort_count); 
+   g_tm_global_statistics.record_tx_profile_commit(m_tx_pc, m_read_word_set.size(), m_write_word_set.size(), gpu_sim_cycle - m_first_start_cycle); 
    g_tm_global_statistics.m_duration.add2bin(gpu_sim_cycle - m_start_cycle); 
    g_tm_global_statistics.m_duration_first_rd.add2bin(gpu_sim_cycle - m_first_read_cycle); 
    g_tm_global_statistics.m_write_buffer_footprint.add2bin(m_buffered_write_word_set.size()); 
@@ -907,6 +968,70 @@ bool conflict_set::conflict() const
    }
 }
 
+conflict_word::accessor* conflict_word::find( unsigned tuid )
+{
+   for (unsigned i = 0; i < m_n_accessors; i++) {
+      if (at(i).m_tuid == tuid) 
+         return &at(i); 
+   }
+   return NULL; 
+}
+
+conflict_word::accessor& conflict_word::find_or_add( unsigned tuid )
+{
+   accessor *acc = find(tuid); 
+   if (acc != NULL) 
+      return *acc; 
+   accessor new_acc; 
+   new_acc.m_tuid = tuid; 
+   new_acc.m_read_mask = 0; 
+   new_acc.m_write_mask = 0; 
+   if (m_n_accessors < N_INLINE) 
+      m_inline[m_n_accessors] = new_acc; 
+   else 
+      m_more.push_back(new_acc); 
+   m_n_accessors++; 
+   return at(m_n_accessors - 1); 
+}
+
+// drop the transactions that no longer read or write any byte of this word 
+void conflict_word::remove_idle_accessors()
+{
+   unsigned n = 0; 
+   for (unsigned i = 0; i < m_n_accessors; i++) {
+      const accessor &acc = at(i); 
+      if (acc.m_read_mask | acc.m_write_mask) {
+         if (n != i) 
+            at(n) = acc; 
+         n++; 
+      }
+   }
+   m_n_accessors = n; 
+   m_more.resize((n > N_INLINE)? n - N_INLINE : 0); 
+}
+
+conflict_byte_state conflict_word::byte_state( unsigned char byte_mask ) const
+{
+   conflict_byte_state state; 
+   state.m_n_readers = 0; 
+   state.m_n_writers = 0; 
+   for (unsigned i = 0; i < m_n_accessors; i++) {
+      const accessor &acc = at(i); 
+      if (acc.m_read_mask & byte_mask) state.m_n_readers++; 
+      if (acc.m_write_mask & byte_mask) state.m_n_writers++; 
+   }
+   return state; 
+}
+
+void conflict_word::get_conflict_set( unsigned char byte_mask, conflict_set &cs ) const
+{
+   for (unsigned i = 0; i < m_n_accessors; i++) {
+      const accessor &acc = at(i); 
+      if (acc.m_read_mask & byte_mask) cs.m_tuids_have_read.insert(acc.m_tuid); 
+      if (acc.m_write_mask & byte_mask) cs.m_tuids_have_written.insert(acc.m_tuid); 
+   }
+}
+
 void tm_sample_conflict_footprint()
 {
    g_tm_global_statistics.sample_footprint(); 
@@ -943,50 +1068,67 @@ void track_delta_change(bool before, bool after, int& value)
    }
 }
 
+void tm_global_state::track_byte_change( const conflict_byte_state &before, const conflict_byte_state &after, bool retain_conflict_max )
+{
+   // update conflict footprint if there is a change in conflict state 
+   track_delta_change(before.conflict(), after.conflict(), m_conflict_footprint); 
+   if (retain_conflict_max) 
+      retainMax<int>(g_tm_global_statistics.m_max_conflict_footprint, m_conflict_footprint); 
+   assert(m_conflict_footprint >= 0); 
+   track_delta_change(before.read_only(), after.read_only(), m_readonly_footprint); 
+   retainMax<int>(g_tm_global_statistics.m_max_readonly_footprint, m_readonly_footprint); 
+   track_delta_change(before.write_only(), after.write_only(), m_writeonly_footprint); 
+   retainMax<int>(g_tm_global_statistics.m_max_writeonly_footprint, m_writeonly_footprint); 
+}
+
+conflict_word& tm_global_state::touch_byte( unsigned addr )
+{
+   conflict_word &word = m_mem[addr >> conflict_word::N_BYTES_LOG2]; 
+   unsigned char byte_mask = 1 << (addr & (conflict_word::N_BYTES - 1)); 
+   if (!(word.m_present_mask & byte_mask)) {
+      word.m_present_mask |= byte_mask; 
+      m_n_mem_bytes++; 
+   }
+   return word; 
+}
+
 tuid_set_t tm_global_state::mem_access( unsigned tuid, bool rd, unsigned addr, unsigned nbytes )
 {
    // piggy-bagging bloomfilter update here 
    memaccess_tx_bf(tuid, rd, addr, nbytes); 
 
 	tuid_set_t result;
-	for( unsigned a=addr; a < (addr+nbytes); ++a ) {
-		conflict_set &cset = m_mem[a];
-      bool conflict_state_before = cset.conflict(); 
-      bool read_only_before = cset.read_only(); 
-      bool write_only_before = cset.write_only(); 
-		if( rd ) {
-			cset.m_tuids_have_read.insert(tuid);
-			tuid_set_t::iterator written_begin = cset.m_tuids_have_written.begin() ;
-			tuid_set_t::iterator written_end = cset.m_tuids_have_written.end() ;
-//			//result.insert( cset.m_tuids_have_written.begin(), cset.m_tuids_have_written.end() );
-         if(!cset.m_tuids_have_written.empty())
-            result.insert( written_begin,written_end );
-		} else {
-			cset.m_tuids_have_written.insert(tuid);
-			tuid_set_t::iterator written_begin = cset.m_tuids_have_written.begin() ;
-			tuid_set_t::iterator written_end = cset.m_tuids_have_written.end() ;
-
-			tuid_set_t::iterator read_begin = cset.m_tuids_have_read.begin() ;
-			tuid_set_t::iterator read_end = cset.m_tuids_have_read.end() ;
-
-			if(!cset.m_tuids_have_read.empty())
-				result.insert( read_begin,read_end );
-			if(!cset.m_tuids_have_written.empty())
-				result.insert( written_begin,written_end );
-		}
-      bool conflict_state_after = cset.conflict(); 
-      bool read_only_after = cset.read_only(); 
-      bool write_only_after = cset.write_only(); 
-
-      // update conflict footprint if there is a change in conflict state 
-      track_delta_change(conflict_state_before, conflict_state_after, m_conflict_footprint); 
-      retainMax<int>(g_tm_global_statistics.m_max_conflict_footprint, m_conflict_footprint); 
-      track_delta_change(read_only_before, read_only_after, m_readonly_footprint); 
-      retainMax<int>(g_tm_global_statistics.m_max_readonly_footprint, m_readonly_footprint); 
-      track_delta_change(write_only_before, write_only_after, m_writeonly_footprint); 
-      retainMax<int>(g_tm_global_statistics.m_max_writeonly_footprint, m_writeonly_footprint); 
-	}
-   retainMax<size_t>(g_tm_global_statistics.m_max_transaction_footprint, m_mem.size()); 
+   unsigned a = addr; 
+   while (a < addr + nbytes) {
+      // bytes of the access within one word share the word lookup and the accessor search 
+      unsigned word_end = ((a >> conflict_word::N_BYTES_LOG2) + 1) << conflict_word::N_BYTES_LOG2; 
+      unsigned end = std::min(addr + nbytes, word_end); 
+      conflict_word &word = m_mem[a >> conflict_word::N_BYTES_LOG2]; 
+      conflict_word::accessor &self = word.find_or_add(tuid); 
+      unsigned char access_mask = 0; 
+      for (; a < end; ++a) {
+         unsigned char byte_mask = 1 << (a & (conflict_word::N_BYTES - 1)); 
+         if (!(word.m_present_mask & byte_mask)) {
+            word.m_present_mask |= byte_mask; 
+            m_n_mem_bytes++; 
+         }
+         conflict_byte_state before = word.byte_state(byte_mask); 
+         if (rd) 
+            self.m_read_mask |= byte_mask; 
+         else 
+            self.m_write_mask |= byte_mask; 
+         track_byte_change(before, word.byte_state(byte_mask), true); 
+         access_mask |= byte_mask; 
+      }
+      // a read conflicts with the writers of the bytes it reads, a write with every accessor 
+      for (unsigned i = 0; i < word.size(); i++) {
+         const conflict_word::accessor &acc = word.at(i); 
+         unsigned char acc_mask = rd? acc.m_write_mask : (acc.m_read_mask | acc.m_write_mask); 
+         if (acc_mask & access_mask) 
+            result.insert(acc.m_tuid); 
+      }
+   }
+   retainMax<size_t>(g_tm_global_statistics.m_max_transaction_footprint, m_n_mem_bytes); 
 	return result;
 }
 
@@ -997,7 +1139,8 @@ void tm_global_state::estimate_coherence_traffic(const addr_set_t& write_set, un
    unsigned coherence_traffic_core_level = 0; 
    addr_set_t::const_iterator i_write_addr = write_set.begin(); 
    for (; i_write_addr != write_set.end(); ++i_write_addr) {
-      const conflict_set &cset = m_mem[*i_write_addr]; 
+      conflict_set cset; 
+      touch_byte(*i_write_addr).get_conflict_set(1 << (*i_write_addr & (conflict_word::N_BYTES - 1)), cset); 
       // this byte needs to be sent to every thread that conflicts 
       tuid_set_t conflict_threads(cset.m_tuids_have_read); // read-write conflict 
       conflict_threads.insert(cset.m_tuids_have_written.begin(), cset.m_tuids_have_written.end()); // write-write conflict 
@@ -1069,47 +1212,43 @@ ptx_thread_info *tm_global_state::lookup_tuid(unsigned tuid)
 	}
 }
 
+void tm_global_state::remove_tuid_accesses( unsigned tuid, const addr_set_t &access_set, bool rd )
+{
+	for( addr_set_t::const_iterator i=access_set.begin(); i != access_set.end(); ++i ) {
+		unsigned addr = *i;
+      unsigned char byte_mask = 1 << (addr & (conflict_word::N_BYTES - 1)); 
+      conflict_byte_state before = {0, 0}; 
+      conflict_byte_state after = {0, 0}; 
+      conflict_mem_t::iterator w = m_mem.find(addr >> conflict_word::N_BYTES_LOG2); 
+      if (w != m_mem.end()) {
+         conflict_word &word = w->second; 
+         before = word.byte_state(byte_mask); 
+         conflict_word::accessor *acc = word.find(tuid); 
+         if (acc != NULL) {
+            if (rd) 
+               acc->m_read_mask &= ~byte_mask; 
+            else 
+               acc->m_write_mask &= ~byte_mask; 
+            if ((acc->m_read_mask | acc->m_write_mask) == 0) 
+               word.remove_idle_accessors(); 
+         }
+         after = word.byte_state(byte_mask); 
+         if (after.empty() && (word.m_present_mask & byte_mask)) {
+            word.m_present_mask &= ~byte_mask; 
+            m_n_mem_bytes--; 
+         }
+         if (word.m_present_mask == 0) 
+            m_mem.erase(w); 
+      }
+      track_byte_change(before, after, false); 
+	}
+}
+
 void tm_global_state::remove_tuid( unsigned tuid, const addr_set_t &read_set, const addr_set_t &write_set )
 {
-	for( addr_set_t::iterator r=read_set.begin(); r != read_set.end(); ++r ) {
-		unsigned addr = *r;
-		conflict_set &cset = m_mem[addr];
-      bool conflict_before = cset.conflict(); 
-      bool read_only_before = cset.read_only(); 
-      bool write_only_before = cset.write_only(); 
-		cset.m_tuids_have_read.erase(tuid);
-      bool conflict_after = cset.conflict(); 
-      bool read_only_after = cset.read_only(); 
-      bool write_only_after = cset.write_only(); 
-      if (conflict_before and not conflict_after) m_conflict_footprint -= 1; 
-      assert(m_conflict_footprint >= 0); 
-      track_delta_change(read_only_before, read_only_after, m_readonly_footprint); 
-      retainMax<int>(g_tm_global_statistics.m_max_readonly_footprint, m_readonly_footprint); 
-      track_delta_change(write_only_before, write_only_after, m_writeonly_footprint); 
-      retainMax<int>(g_tm_global_statistics.m_max_writeonly_footprint, m_writeonly_footprint); 
-		if( cset.m_tuids_have_read.empty() && cset.m_tuids_have_written.empty() ) 
-			m_mem.erase(addr);
-	}
-	for( addr_set_t::iterator w=write_set.begin(); w != write_set.end(); ++w ) {
-		unsigned addr = *w;
-		conflict_set &cset = m_mem[addr];
-      bool conflict_before = cset.conflict(); 
-      bool read_only_before = cset.read_only(); 
-      bool write_only_before = cset.write_only(); 
-		cset.m_tuids_have_written.erase(tuid);
-      bool conflict_after = cset.conflict(); 
-      bool read_only_after = cset.read_only(); 
-      bool write_only_after = cset.write_only(); 
-      if (conflict_before and not conflict_after) m_conflict_footprint -= 1; 
-      assert(m_conflict_footprint >= 0); 
-      track_delta_change(read_only_before, read_only_after, m_readonly_footprint); 
-      retainMax<int>(g_tm_global_statistics.m_max_readonly_footprint, m_readonly_footprint); 
-      track_delta_change(write_only_before, write_only_after, m_writeonly_footprint); 
-      retainMax<int>(g_tm_global_statistics.m_max_writeonly_footprint, m_writeonly_footprint); 
-		if( cset.m_tuids_have_read.empty() && cset.m_tuids_have_written.empty() ) 
-			m_mem.erase(addr);
-	}
-   retainMax<size_t>(g_tm_global_statistics.m_max_transaction_footprint, m_mem.size()); 
+   remove_tuid_accesses(tuid, read_set, true); 
+   remove_tuid_accesses(tuid, write_set, false); 
+   retainMax<size_t>(g_tm_global_statistics.m_max_transaction_footprint, m_n_mem_bytes); 
 }
 
 tuid_set_t tm_global_state::lazy_conflict_detection( const addr_set_t& write_set )
@@ -1117,7 +1256,8 @@ tuid_set_t tm_global_state::lazy_conflict_detection( const addr_set_t& write_set
    tuid_set_t conflicting_threads; 
 
    for (addr_set_t::const_iterator w = write_set.begin(); w != write_set.end(); ++w) {
-      conflict_set& cs = m_mem[*w]; 
+      conflict_set cs; 
+      touch_byte(*w).get_conflict_set(1 << (*w & (conflict_word::N_BYTES - 1)), cs); 
       conflicting_threads.insert(cs.m_tuids_have_read.begin(), cs.m_tuids_have_read.end()); 
       conflicting_threads.insert(cs.m_tuids_have_written.begin(), cs.m_tuids_have_written.end()); 
       g_tm_global_statistics.record_abort_at_address(*w, cs); 
@@ -1150,6 +1290,93 @@ void tm_global_statistics::dump_abort_profile(FILE *csv)
    }
 }
 
+void tm_global_statistics::record_tx_profile_commit(address_type tx_pc, size_t read_size, size_t write_size, unsigned long long cycles)
+{
+   if (g_tm_options.m_tx_profile == false) return; 
+
+   tm_tx_profile_entry &tx = m_tx_profile[tx_pc]; 
+   tx.m_n_commits += 1; 
+   tx.m_tot_read_size += read_size; 
+   tx.m_tot_write_size += write_size; 
+   tx.m_tot_cycles += cycles; 
+}
+
+void tm_global_statistics::record_tx_profile_abort(address_type tx_pc, enum tm_abort_cause_t cause, addr_t addr, address_type conflict_pc)
+{
+   if (g_tm_options.m_tx_profile == false) return; 
+
+   tm_tx_profile_entry &tx = m_tx_profile[tx_pc]; 
+   tx.m_n_aborts += 1; 
+   tx.m_n_abort_cause[cause] += 1; 
+   if (cause == TM_ABORT_OTHER) return; 
+   if (addr != 0) tx.m_abort_addr[addr] += 1; 
+   if (conflict_pc != 0) tx.m_abort_pc[conflict_pc] += 1; 
+}
+
+void tm_global_statistics::record_tx_profile_access(addr_t waddr, bool rd, address_type pc)
+{
+   if (g_tm_options.m_tx_profile == false) return; 
+
+   if (rd) m_tx_profile_read_pc[waddr] = pc; 
+   else m_tx_profile_write_pc[waddr] = pc; 
+}
+
+address_type tm_global_statistics::tx_profile_last_pc(addr_t waddr, bool rd) const
+{
+   const tr1_hash_map<addr_t, address_type> &last_pc = (rd)? m_tx_profile_read_pc : m_tx_profile_write_pc; 
+   tr1_hash_map<addr_t, address_type>::const_iterator i = last_pc.find(waddr); 
+   return (i != last_pc.end())? i->second : 0; 
+}
+
+void tm_global_statistics::clear_tx_profile()
+{
+   m_tx_profile.clear(); 
+   m_tx_profile_read_pc.clear(); 
+   m_tx_profile_write_pc.clear(); 
+}
+
+// return the most frequent key in an abort attribution map (count = 0 if empty) 
+template<class K> 
+static K tx_profile_top(const std::map<K, unsigned> &counts, unsigned &count) 
+{
+   K top = 0; 
+   count = 0; 
+   for (typename std::map<K, unsigned>::const_iterator i = counts.begin(); i != counts.end(); ++i) {
+      if (i->second > count) {
+         top = i->first; 
+         count = i->second; 
+      }
+   }
+   return top; 
+}
+
+void tm_global_statistics::print_tx_profile(FILE *fout) 
+{
+   if (g_tm_options.m_tx_profile == false) return; 
+
+   fprintf(fout, "tm_tx_profile:\n"); 
+   fprintf(fout, "%10s %10s %10s %8s %8s %8s %8s %8s %8s %8s %8s %8s %8s %8s %8s %10s %10s(%6s) %10s(%6s)\n", 
+           "tx_pc", "commits", "aborts", "raw", "war", "waw", "stall", "value", "cmtwin", "cu_val", "cu_cft", "intrawp", "other", 
+           "avg_rd", "avg_wr", "avg_cycle", "top_addr", "n", "top_pc", "n"); 
+   for (std::map<address_type, tm_tx_profile_entry>::const_iterator iTx = m_tx_profile.begin(); iTx != m_tx_profile.end(); ++iTx) {
+      const tm_tx_profile_entry &tx = iTx->second; 
+      unsigned long long n_commits = (tx.m_n_commits > 0)? tx.m_n_commits : 1; 
+      unsigned n_top_addr, n_top_pc; 
+      addr_t top_addr = tx_profile_top(tx.m_abort_addr, n_top_addr); 
+      address_type top_pc = tx_profile_top(tx.m_abort_pc, n_top_pc); 
+      fprintf(fout, "%#10x %10llu %10llu %8llu %8llu %8llu %8llu %8llu %8llu %8llu %8llu %8llu %8llu %8.1f %8.1f %10.1f %#10x(%6u) %#10x(%6u)\n", 
+              iTx->first, tx.m_n_commits, tx.m_n_aborts, 
+              tx.m_n_abort_cause[TM_ABORT_RAW], tx.m_n_abort_cause[TM_ABORT_WAR], tx.m_n_abort_cause[TM_ABORT_WAW], 
+              tx.m_n_abort_cause[TM_ABORT_STALL_FULL], tx.m_n_abort_cause[TM_ABORT_VALUE], 
+              tx.m_n_abort_cause[TM_ABORT_COMMITTER_WIN], tx.m_n_abort_cause[TM_ABORT_CU_VALIDATION], 
+              tx.m_n_abort_cause[TM_ABORT_CU_CONFLICT], tx.m_n_abort_cause[TM_ABORT_INTRA_WARP], 
+              tx.m_n_abort_cause[TM_ABORT_OTHER], 
+              (float)tx.m_tot_read_size / n_commits, (float)tx.m_tot_write_size / n_commits, 
+              (float)tx.m_tot_cycles / n_commits, 
+              top_addr, n_top_addr, top_pc, n_top_pc); 
+   }
+}
+
 void tm_dump_profile()
 {
    if (g_tm_options.m_abort_profile) {
@@ -1335,7 +1562,7 @@ void tm_global_state::abort_tx_bf( unsigned tuid )
 
 void tm_global_state::print_resource_usage( FILE *fout ) 
 {
-   fprintf(fout, "m_mem.size = %zd\n", m_mem.size()); 
+   fprintf(fout, "m_mem.size = %zd\n", m_n_mem_bytes); 
    fprintf(fout, "m_tlookup.size = %zd\n", m_tlookup.size()); 
    fprintf(fout, "m_bfaccess.size = %zd\n", m_bfaccess.size()); 
    fprintf(fout, "m_bfcore.size = %zd\n", m_bfcore.size()); 
@@ -1350,6 +1577,7 @@ tm_manager::access_record::access_record( const access_record &another )
 	m_nbytes = another.m_nbytes;
 	m_bytes = malloc(m_nbytes);
 	memcpy(m_bytes,another.m_bytes,m_nbytes);
+	m_pc = another.m_pc;
 }
 
 tm_manager::access_record::access_record( tm_manager *parent, memory_space *mem, bool rd, addr_t addr, void *data, unsigned nbytes )
@@ -1361,6 +1589,7 @@ tm_manager::access_record::access_record( tm_manager *parent, memory_space *mem,
 	m_nbytes = nbytes;
 	m_bytes = malloc(nbytes);
 	memcpy(m_bytes,data,nbytes);
+	m_pc = (parent->m_thread != NULL)? parent->m_thread->get_pc() : 0;
 }
 
 
@@ -1380,6 +1609,9 @@ void tm_manager::access_record::commit()
 		}
 #endif
         m_mem->write(m_addr, m_nbytes, m_bytes, NULL /*thread*/, NULL /*pI*/);
+        addr_t word_size_log2 = g_tm_options.m_word_size_log2; 
+        for (addr_t waddr = m_addr >> word_size_log2; waddr <= (m_addr + m_nbytes - 1) >> word_size_log2; waddr++) 
+           g_tm_global_statistics.record_tx_profile_access(waddr, false, m_pc); 
 	}
 }
 
@@ -1394,10 +1626,11 @@ void tm_manager::access_record::commit_word( addr_t addr, unsigned nbytes )
    addr_t offset = addr - m_addr; 
    char * data = ((char *) m_bytes) + offset; 
    m_mem->write(addr, nbytes, (void*)data, NULL /*thread*/, NULL /*pI*/);
+   g_tm_global_statistics.record_tx_profile_access(addr >> g_tm_options.m_word_size_log2, false, m_pc); 
 }
 
 // return true if the access_record contain the given address range [addr, addr + nbytes)
-bool tm_manager::access_record::contain_addr( addr_t addr, unsigned nbytes )
+bool tm_manager::access_record::contain_addr( addr_t addr, unsigned nbytes ) const
 {
    addr_t access_bound[2] = { m_addr, m_addr + m_nbytes };
    addr_t word_bound[2] = { addr, addr + nbytes }; 
@@ -1442,6 +1675,10 @@ void tm_global_statistics::print(FILE *fout)
     fprintf(fout, "tm_n_transactions = %llu \n", m_n_transactions); 
     fprintf(fout, "tm_n_intra_warp_detected_conflicts = %llu \n", m_n_intra_warp_detected_conflicts); 
     fprintf(fout, "tm_n_vcd_tcd_mismatch = %llu \n", m_n_vcd_tcd_mismatch); 
+    fprintf(fout, "tm_n_version_validated = %llu \n", m_n_version_validated); 
+    fprintf(fout, "tm_n_silent_stores = %llu \n", m_n_silent_stores); 
+    fprintf(fout, "tm_n_silent_store_aborts_avoided = %llu \n", m_n_silent_store_aborts_avoided); 
+    fprintf(fout, "tm_n_written_mask_aborts_avoided = %llu \n", m_n_written_mask_aborts_avoided); 
     m_aborts_per_transaction.fprint(fout); fprintf(fout, "\n"); 
     m_duration.fprint(fout); fprintf(fout, "\n"); 
     m_duration_first_rd.fprint(fout); fprintf(fout, "\n"); 
@@ -1567,6 +1804,16 @@ void tm_global_statistics::print(FILE *fout)
     fprintf(fout, "tm_tot_cuckoo_table_aborts_per_addr = %llu \n", m_tot_cuckoo_table_aborts_per_addr);
 
     fprintf(fout, "tm_tot_cuckoo_table_splited_addr = %llu \n", m_tot_cuckoo_table_splited_addr);
+    if (g_tm_options.m_logical_temporal_adaptive_granularity) {
+        fprintf(fout, "tm_n_granularity_true_aborts = %llu \n", m_n_granularity_true_aborts);
+        fprintf(fout, "tm_n_granularity_false_aborts = %llu \n", m_n_granularity_false_aborts);
+        fprintf(fout, "tm_n_granularity_split_false_aborts = %llu \n", m_n_granularity_split_false_aborts);
+        fprintf(fout, "tm_granularity_timeline = cycle:chunk_entries:split_words:true_aborts:false_aborts\n");
+        for (auto iter = m_granularity_timeline.begin(); iter != m_granularity_timeline.end(); iter++) {
+            fprintf(fout, "%llu:%u:%u:%u:%u\n", iter->m_cycle, iter->m_chunk_entries, iter->m_split_words, 
+                    iter->m_true_aborts, iter->m_false_aborts);
+        }
+    }
 
     fprintf(fout, "tm_largest_pts = %llu \n", m_largest_pts);
     
@@ -1605,9 +1852,15 @@ void tm_statistics_visualizer( gzFile visualizer_file )
 void tm_statistics(FILE *fout)
 {
     g_tm_global_statistics.print(fout); 
+    g_tm_global_statistics.print_tx_profile(fout); 
     g_tm_ring_stats.print(fout); 
 }
 
+void tm_new_kernel()
+{
+    g_tm_global_statistics.clear_tx_profile(); 
+}
+
 void tm_reg_options(option_parser_t opp) 
 {
    g_tm_options.reg_options(opp); 
@@ -1617,7 +1870,7 @@ void tm_reg_options(option_parser_t opp)
 tm_options::tm_options()
    : m_derive_done(false), m_word_size(4), m_word_size_log2(2), 
      m_access_block_size(256), m_access_block_size_log2(8), 
-     m_abort_profile(false), 
+     m_abort_profile(false), m_tx_profile(false), 
      m_use_ring_tm(false), m_ring_tm_eager_cd(false)
 { }
 
@@ -1650,6 +1903,24 @@ void tm_options::check_n_derive()
       assert(timing_mode_vb_commit == true); 
    }
 
+   // the fallback lock pauses transactions in flight, which must not hold write ownership 
+   unsigned tm_fallback_abort_limit; 
+   option_parser_getvalue(m_opp, "-scb_tm_fallback_abort_limit", OPT_UINT32, &tm_fallback_abort_limit); 
+   if (tm_fallback_abort_limit != 0 and (not m_use_value_based_tm or m_use_logical_timestamp_based_tm or m_eager_warptm_enabled)) {
+      printf("GPGPU-Sim uArch: ERROR ** -scb_tm_fallback_abort_limit requires value-based TM without logical timestamps or eager WarpTM\n"); 
+      abort(); 
+   }
+
+   if (m_logical_temporal_adaptive_granularity and not m_logical_temporal_cuckoo_table_multiple_granularity_enabled) {
+      printf("GPGPU-Sim uArch: ERROR ** -tm_logical_temporal_adaptive_granularity requires -tm_logical_temporal_cuckoo_table_multiple_granularity_enabled\n"); 
+      abort(); 
+   }
+
+   if (m_logical_temporal_written_mask_filter and m_logical_temporal_cuckoo_table_multiple_granularity_enabled) {
+      printf("GPGPU-Sim uArch: ERROR ** -tm_logical_temporal_written_mask_filter does not apply to the multiple granularity cuckoo table\n"); 
+      abort(); 
+   }
+
    m_temporal_cd_addr_granularity_log2 = 0; 
    while ((1 << m_temporal_cd_addr_granularity_log2) < m_temporal_cd_addr_granularity) {
       m_temporal_cd_addr_granularity_log2 += 1; 
@@ -1685,6 +1956,9 @@ void tm_options::reg_options(option_parser_t opp)
    option_parser_register(opp, "-tm_abort_profile", OPT_BOOL, &m_abort_profile, 
                "create a profile of abort causing memory locations (default = off)",
                "0");
+   option_parser_register(opp, "-tm_tx_profile", OPT_BOOL, &m_tx_profile, 
+               "print commits, aborts and abort causes per static transaction (tx_begin pc) at kernel end (default = off)",
+               "0");
    option_parser_register(opp, "-tm_use_ring_tm", OPT_BOOL, &m_use_ring_tm, 
                "use ring TM mechanism (committer-abortee) (default = off)",
                "0");
@@ -1742,6 +2016,10 @@ void tm_options::reg_options(option_parser_t opp)
    option_parser_register(opp, "-tm_temporal_cd_addr_granularity", OPT_UINT32, &m_temporal_cd_addr_granularity, 
                "address granularity (in bytes) of temporal conflict detection",
                "4");
+   option_parser_register(opp, "-tm_functional_warmup_temporal_cd", OPT_BOOL, &m_functional_warmup_temporal_cd, 
+               "update the temporal conflict detector with transactions committed in functional simulation, "
+               "e.g. before the region of interest (default = off)",
+               "0");
    option_parser_register(opp, "-tm_use_logical_timestamp_based_tm", OPT_BOOL, &m_use_logical_timestamp_based_tm, 
                "use logical-timestamp-based conflict detection TM mechanism (committer-abortee) (default = off)",
                "0");
@@ -1811,6 +2089,13 @@ void tm_options::reg_options(option_parser_t opp)
    option_parser_register(opp, "-tm_logical_temporal_cuckoo_table_check_raw_granularity", OPT_UINT32, &m_logical_temporal_cuckoo_table_check_raw_granularity, 
                "which granularity will be used while check raw in cuckoo table",
                "4");
+   option_parser_register(opp, "-tm_logical_temporal_written_mask_filter", OPT_BOOL, &m_logical_temporal_written_mask_filter, 
+               "let reads pass on words of a chunk that no pending writer has written before any of the writers commits, "
+               "independent of -tm_logical_temporal_cuckoo_table_check_raw (not with multiple granularity)",
+               "0");
+   option_parser_register(opp, "-tm_logical_temporal_silent_store_filter", OPT_BOOL, &m_logical_temporal_silent_store_filter, 
+               "track a transactional store that does not change global memory as a read and do not write it back at commit",
+               "0");
    option_parser_register(opp, "-tm_logical_timestamp_tm_stall_queue_size", OPT_UINT32, &m_logical_timestamp_tm_stall_queue_size, 
                "tm stall queue size in logical timestamp based tm manager",
                "16");
@@ -1832,6 +2117,10 @@ void tm_options::reg_options(option_parser_t opp)
    option_parser_register(opp, "-tm_logical_temporal_cuckoo_table_num_aborts_dec_period", OPT_UINT32, &m_logical_temporal_cuckoo_table_num_aborts_dec_period, 
                "number of aborts decrement period in logical timestamp based tm manager",
                "1000");
+   option_parser_register(opp, "-tm_logical_temporal_adaptive_granularity", OPT_BOOL, &m_logical_temporal_adaptive_granularity, 
+               "split and merge multiple granularity cuckoo table entries by estimated false conflicts and 4B table occupancy "
+               "(requires -tm_logical_temporal_cuckoo_table_multiple_granularity_enabled)",
+               "0");
 
    // Parameters for LSU HPCA2016 Early Abort paper
    option_parser_register(opp, "-tm_lsu_hpca_enabled", OPT_BOOL, &m_lsu_hpca_enabled, 
@@ -2315,6 +2604,34 @@ void temporal_conflict_detector::dump( FILE *fp )
    }
 }
 
+void temporal_conflict_detector::save_checkpoint( FILE *fp ) const
+{
+   ckpt_write_tag(fp, "temporal_cd"); 
+   size_t n_words = m_last_written_timetable.size(); 
+   ckpt_write(fp, n_words); 
+   for (auto iword = m_last_written_timetable.begin(); iword != m_last_written_timetable.end(); ++iword) {
+      ckpt_write(fp, iword->first); 
+      ckpt_write(fp, iword->second); 
+   }
+   m_rbloomfilter->save_checkpoint(fp); 
+}
+
+void temporal_conflict_detector::load_checkpoint( FILE *fp )
+{
+   ckpt_check_tag(fp, "temporal_cd"); 
+   size_t n_words; 
+   ckpt_read(fp, n_words); 
+   m_last_written_timetable.clear(); 
+   for (size_t w = 0; w < n_words; w++) {
+      addr_t chunk_addr; 
+      tm_timestamp_t last_written; 
+      ckpt_read(fp, chunk_addr); 
+      ckpt_read(fp, last_written); 
+      m_last_written_timetable[chunk_addr] = last_written; 
+   }
+   m_rbloomfilter->load_checkpoint(fp); 
+}
+
 // global singleton
 temporal_conflict_detector * temporal_conflict_detector::s_temporal_conflict_detector = NULL;
 
@@ -2331,7 +2648,7 @@ temporal_conflict_detector& temporal_conflict_detector::get_singleton()
 // Value-based conflict detection 
 
 value_based_tm_manager::value_based_tm_manager( ptx_thread_info *thread, bool timing_mode )
-   : tm_manager(thread, timing_mode), m_violated(false), m_gmem(NULL), m_last_validation(0),
+   : tm_manager(thread, timing_mode), m_violated(false), m_gmem(NULL), m_validated_clock(0), m_last_validation(0),
      m_n_reread(0), m_n_reread_violation(0), m_n_timeout(0), m_warp_level_raw(0) 
 { }
 
@@ -2390,9 +2707,12 @@ bool value_based_tm_manager::at_access( memory_space *mem, bool potential_confli
          if (iAdValue->second != mem_value) {
             m_violated = true; 
             m_n_reread_violation += 1; 
+            set_abort_cause(TM_ABORT_VALUE, waddr << word_size_log2, g_tm_global_statistics.tx_profile_last_pc(waddr, false)); 
          }
       } else {
          // this is a new read, buffer the mem value  
+         if (m_read_set_value.empty()) 
+            m_validated_clock = mem->write_clock(); 
          m_read_set_value[waddr] = mem_value; 
       }
 
@@ -2443,23 +2763,43 @@ void value_based_tm_manager::at_commit_success()
 
 void value_based_tm_manager::validate() 
 {
-   addr_t word_size = g_tm_options.m_word_size; 
    addr_t word_size_log2 = g_tm_options.m_word_size_log2; 
 
+   if (m_gmem == NULL) return; // empty read-set 
+   unsigned long long clock = m_gmem->write_clock(); 
+
    // run though the whole read set and ensure that the buffered value is not changed in memory 
    for (addr_value_t::const_iterator iAdValue = m_read_set_value.begin(); 
         iAdValue != m_read_set_value.end(); ++iAdValue) 
    {
       unsigned int mem_value = 0; 
-      m_gmem->read(iAdValue->first << word_size_log2, word_size, &mem_value); 
-      if (iAdValue->second != mem_value) {
+      if (not read_set_word_valid(iAdValue->first, iAdValue->second, mem_value)) {
          m_violated = true; 
+         set_abort_cause(TM_ABORT_VALUE, iAdValue->first << word_size_log2, g_tm_global_statistics.tx_profile_last_pc(iAdValue->first, false)); 
       }
       if (watched()) {
          printf("[TMM-%llu] Thd %u timeout-validates addr[%#08x]=%#x see %#x in GMem\n", 
                 gpu_sim_cycle + gpu_tot_sim_cycle, m_thread_uid, iAdValue->first << word_size_log2, iAdValue->second, mem_value);
       }
    }
+   if (not m_violated) 
+      m_validated_clock = clock; 
+}
+
+// true if the buffered value of a read-set word still matches global memory; words in blocks 
+// that have not been written since the read-set was last validated are not read again 
+bool value_based_tm_manager::read_set_word_valid( addr_t waddr, unsigned int value, unsigned int &mem_value )
+{
+   addr_t word_size = g_tm_options.m_word_size; 
+   addr_t vAddr = waddr << g_tm_options.m_word_size_log2; 
+   if (m_gmem->unchanged_since(vAddr, word_size, m_validated_clock)) {
+      g_tm_global_statistics.m_n_version_validated += 1; 
+      mem_value = value; 
+      return true; 
+   }
+   mem_value = 0; 
+   m_gmem->read(vAddr, word_size, &mem_value); 
+   return (mem_value == value); 
 }
 
 bool value_based_tm_manager::validate_all( bool useTemporalCD ) 
@@ -2534,7 +2874,6 @@ tr1_hash_map<addr_t, last_writer_info> g_last_writer;
 // for a given word, return true if the buffered value in TM manager is still consistent with global memory 
 bool value_based_tm_manager::validate_addr( addr_t addr ) 
 { 
-   addr_t word_size = g_tm_options.m_word_size; 
    addr_t word_size_log2 = g_tm_options.m_word_size_log2; 
 
    addr_value_t::const_iterator iAdValue; 
@@ -2542,14 +2881,16 @@ bool value_based_tm_manager::validate_addr( addr_t addr )
    assert(iAdValue != m_read_set_value.end()); 
 
    unsigned int mem_value = 0;
-   m_gmem->read(addr, word_size, &mem_value); 
+   bool valid = read_set_word_valid(iAdValue->first, iAdValue->second, mem_value); 
+   if (not valid) 
+      set_abort_cause(TM_ABORT_CU_VALIDATION, addr, g_tm_global_statistics.tx_profile_last_pc(iAdValue->first, false)); 
 
    if (watched()) {
       printf("[TMM-%llu] Thd %u validates addr[%#08x]=%#x see %#x in GMem\n", 
              gpu_sim_cycle + gpu_tot_sim_cycle, m_thread_uid, addr, iAdValue->second, mem_value);
    }
 
-   return (iAdValue->second == mem_value); 
+   return valid; 
 }
 
 void value_based_tm_manager::commit_addr( addr_t addr ) 
@@ -2605,7 +2946,6 @@ void value_based_tm_manager::commit_addr( addr_t addr )
 // ensure the committing transaction is still consistent 
 void value_based_tm_manager::validate_or_crash( ) 
 {  
-   addr_t word_size = g_tm_options.m_word_size; 
    addr_t word_size_log2 = g_tm_options.m_word_size_log2; 
 
    // run though the whole read set and ensure that the buffered value is not changed in memory 
@@ -2617,8 +2957,7 @@ void value_based_tm_manager::validate_or_crash( )
       unsigned int vVal = iAdValue->second; 
       if (m_committed_set.find(vAddr) == m_committed_set.end()) {
          unsigned int mem_value = 0; 
-         m_gmem->read(vAddr, word_size, &mem_value); 
-         if (vVal != mem_value) {
+         if (not read_set_word_valid(iAdValue->first, vVal, mem_value)) {
             #ifdef track_last_writer
             last_writer_info &last_writer = g_last_writer.find(vAddr)->second;
             printf("[TMM-%llu] Validation protection failed @ %#08x: expects %x but sees %x, last writer=(%u,%u,%u)-%llu\n", 
@@ -2678,10 +3017,12 @@ void value_based_tm_manager::commit_core_side( )
 	g_tm_global_statistics.m_n_commits += 1;
    if (writing_tx) g_tm_global_statistics.m_n_writing_commits += 1;
 	g_tm_global_statistics.dec_concurrency();
-   g_tm_global_statistics.record_commit_tx_size(m_read_word_set.size(), m_write_word_set.size(), m_access_word_set.size());
+   g_tm_global_statistics.record_commit_tx_size(m_read_word_set.size(), m_write_word_set.size(), access_word_count());
+   derive_block_sets(); 
    g_tm_global_statistics.record_tx_blockcount(m_read_block_set, m_write_block_set, m_access_block_set); 
    g_tm_global_statistics.record_raw_info(m_raw_set.size(), m_raw_access); 
    g_tm_global_statistics.m_aborts_per_transaction.add2bin(m_abort_count); 
+   g_tm_global_statistics.record_tx_profile_commit(m_tx_pc, m_read_word_set.size(), m_write_word_set.size(), gpu_sim_cycle - m_first_start_cycle); 
    g_tm_global_statistics.m_duration.add2bin(gpu_sim_cycle - m_start_cycle); 
    g_tm_global_statistics.m_duration_first_rd.add2bin(gpu_sim_cycle - m_first_read_cycle); 
    g_tm_global_statistics.m_write_buffer_footprint.add2bin(m_buffered_write_word_set.size()); 
@@ -2798,6 +3139,10 @@ additional_write_info::additional_write_info() {
     assert(cuckoo_table_granularity%4 == 0);
     unsigned split_mask_size = cuckoo_table_granularity/4;
     m_split_mask.resize(split_mask_size, false);
+
+    m_rts_word_warp.resize(split_mask_size, warp_logical_id(-1, -1));
+    m_wts_word_warp.resize(split_mask_size, warp_logical_id(-1, -1));
+    m_num_false_aborts = 0;
 }
 
 void additional_write_info::reset() {
@@ -2810,12 +3155,21 @@ void additional_write_info::reset() {
     for (unsigned i = 0; i < m_split_mask.size(); i++) {
         m_split_mask[i] = false;
     }
+    m_num_false_aborts = 0;
 }
 
-bool additional_write_info::raw_pass(addr_t addr, tm_timestamp_t req_timestamp) {
+bool additional_write_info::raw_pass(addr_t addr, tm_timestamp_t req_timestamp, bool *mask_filter_pass) {
+    if (mask_filter_pass) *mask_filter_pass = false;
+    unsigned index = get_word_index(addr);
     if (m_num_writing_decreased) {
-	unsigned index = get_word_index(addr);
+        // after a commit: -tm_logical_temporal_cuckoo_table_check_raw only 
+        if (g_tm_options.m_logical_temporal_cuckoo_table_check_raw == false) return false;
         return m_written_word_mask[index] == false and req_timestamp >= m_old_wts;
+    } else if (g_tm_options.m_logical_temporal_written_mask_filter) {
+        // the mask holds every word written since the first pending writer, so it is exact before any commit too
+        bool pass = m_written_word_mask[index] == false and req_timestamp >= m_old_wts;
+        if (mask_filter_pass) *mask_filter_pass = pass;
+        return pass;
     } else {
         return req_timestamp >= m_old_wts;
     }
@@ -2845,6 +3199,28 @@ bool additional_write_info::splited(unsigned index) { assert(index < m_split_mas
 void additional_write_info::set_split_mask(unsigned index) { assert(index < m_split_mask.size()); m_split_mask[index] = true; }
 void additional_write_info::clear_split_mask(unsigned index) { assert(index < m_split_mask.size()); m_split_mask[index] = false; }
 
+// only accesses at the chunk's current timestamp are kept: once it advances, the words touched 
+// at the old one can no longer cause an abort 
+void additional_write_info::record_word_access(unsigned index, bool rd, tm_timestamp_t new_time, tm_timestamp_t old_time, warp_logical_id warp) {
+    std::vector<warp_logical_id> &word_warp = rd ? m_rts_word_warp : m_wts_word_warp;
+    assert(index < word_warp.size());
+    if (new_time < old_time) return;
+    if (new_time > old_time) 
+        std::fill(word_warp.begin(), word_warp.end(), warp_logical_id(-1, -1));
+    if (word_warp[index].first == -1 or word_warp[index] == warp) 
+        word_warp[index] = warp;
+    else 
+        word_warp[index] = warp_logical_id(-2, -2);
+}
+
+// a read only conflicts with writes to its word, a write with any access to it, 
+// and neither with the warp's own accesses 
+bool additional_write_info::word_conflict(unsigned index, bool rd, warp_logical_id warp) const {
+    assert(index < m_wts_word_warp.size());
+    if (m_wts_word_warp[index].first != -1 and m_wts_word_warp[index] != warp) return true;
+    return (not rd and m_rts_word_warp[index].first != -1 and m_rts_word_warp[index] != warp);
+}
+
 /////////////////////////////////////////////////////////////////////////////////
 // Logical Temporal Conflict Detector
 logical_temporal_conflict_detector::logical_temporal_conflict_detector()
@@ -2856,6 +3232,10 @@ logical_temporal_conflict_detector::logical_temporal_conflict_detector()
    m_warp_pts_current.resize(num_shader*max_warps_per_shader, 0);
    m_largest_pts.resize(num_shader, 0);
 
+   m_capacity_4B = g_tm_options.m_logical_temporal_cuckoo_table_4B_size * g_tm_options.m_logical_temporal_cuckoo_table_n_hash;
+   m_epoch_true_aborts = 0;
+   m_epoch_false_aborts = 0;
+
    m_cuckoo_table = new cuckoo_model(g_tm_options.m_logical_temporal_cuckoo_table_size,
 		                     g_tm_options.m_logical_temporal_cuckoo_table_n_hash,
 		                     g_tm_options.m_logical_temporal_cuckoo_table_max_insert_probe,
@@ -3087,8 +3467,7 @@ bool logical_temporal_conflict_detector::something_pending(addr_t chunk_addr) {
        assert(m_latest_written_timetable.count(chunk_addr) > 0);
        assert(m_latest_read_timetable.count(chunk_addr) > 0);
        if (m_num_writing_threads.count(chunk_addr) > 0) {
-	   unsigned num_aborts = m_num_writing_threads[chunk_addr].second.get_num_aborts();
-	   bool over_limit = num_aborts > g_tm_options.m_logical_temporal_cuckoo_table_num_aborts_limit;
+	   bool over_limit = split_wanted(chunk_addr);
            if (m_num_writing_threads[chunk_addr].first > 0)
 	       return true;
 	   else if (m_num_writing_threads[chunk_addr].second.splited())
@@ -3163,6 +3542,8 @@ void logical_temporal_conflict_detector::update_logical_timestamp(addr_t addr, b
            if (rd) {
                assert(m_latest_read_timetable.count(chunk_addr) > 0);
                tm_timestamp_t old_time = m_latest_read_timetable[chunk_addr].first;
+	       if (g_tm_options.m_logical_temporal_adaptive_granularity)
+	           m_num_writing_threads[chunk_addr].second.record_word_access(get_word_index_in_chunk(addr), rd, new_time, old_time, warp_logical_id(shader_id, warp_id));
                if (new_time > old_time) {
                    tm_logical_timestamp_t new_logical_time;
                    new_logical_time = tm_logical_timestamp_t(new_time, warp_logical_id(shader_id, warp_id)); 
@@ -3172,6 +3553,8 @@ void logical_temporal_conflict_detector::update_logical_timestamp(addr_t addr, b
                assert(m_latest_written_timetable.count(chunk_addr) > 0);
                tm_timestamp_t old_time = m_latest_written_timetable[chunk_addr].first;
                assert(new_time >= old_time);
+	       if (g_tm_options.m_logical_temporal_adaptive_granularity)
+	           m_num_writing_threads[chunk_addr].second.record_word_access(get_word_index_in_chunk(addr), rd, new_time, old_time, warp_logical_id(shader_id, warp_id));
                tm_logical_timestamp_t new_logical_time;
                new_logical_time = tm_logical_timestamp_t(new_time, warp_logical_id(shader_id, warp_id)); 
                m_latest_written_timetable[chunk_addr] = new_logical_time;
@@ -3509,17 +3892,19 @@ void logical_temporal_conflict_detector::num_tm_cuckoo_cycles(mem_fetch *mf) {
     mf->set_tm_cuckoo_cycles(num_check_cycles); 
 }
 
-bool logical_temporal_conflict_detector::raw_pass(addr_t addr, tm_timestamp_t wts, tm_timestamp_t warp_pts) 
+bool logical_temporal_conflict_detector::raw_pass(addr_t addr, tm_timestamp_t wts, tm_timestamp_t warp_pts, bool *mask_filter_pass) 
 {
+    if (mask_filter_pass) *mask_filter_pass = false;
     if (g_tm_options.m_logical_temporal_cuckoo_table_multiple_granularity_enabled) return false;
-    if (g_tm_options.m_logical_temporal_cuckoo_table_check_raw == false) return false;
+    if (g_tm_options.m_logical_temporal_cuckoo_table_check_raw == false and 
+        g_tm_options.m_logical_temporal_written_mask_filter == false) return false;
     if (get_num_writing_threads(addr) == 0) return false;
     if (wts <= warp_pts) return false;
     
     addr_t chunk_addr = get_chunk_address(addr);
-    bool exact_pass = m_exact_num_writing_threads[chunk_addr].second.raw_pass(addr, warp_pts);
+    bool exact_pass = m_exact_num_writing_threads[chunk_addr].second.raw_pass(addr, warp_pts, mask_filter_pass);
     if (g_tm_options.m_logical_temporal_use_cuckoo_table) {
-        bool approx_pass = m_num_writing_threads[chunk_addr].second.raw_pass(addr, warp_pts);
+        bool approx_pass = m_num_writing_threads[chunk_addr].second.raw_pass(addr, warp_pts, mask_filter_pass);
 	return approx_pass;
     }
     return exact_pass;
@@ -3572,9 +3957,24 @@ unsigned logical_temporal_conflict_detector::get_num_aborts_4B(addr_t addr)
     }    
 }
 
-void logical_temporal_conflict_detector::inc_num_aborts(addr_t addr) 
+void logical_temporal_conflict_detector::inc_num_aborts(addr_t addr, bool rd, unsigned int shader_id, unsigned int warp_id) 
 {
     addr_t chunk_addr = get_chunk_address(addr);
+    if (g_tm_options.m_logical_temporal_adaptive_granularity and m_latest_written_timetable.count(chunk_addr) > 0) {
+        // classify before counting: an abort on a word-grained entry is a true conflict, on a chunk 
+        // entry it is false if no other warp's access at the chunk's current timestamps touched the word 
+        additional_write_info &info = m_num_writing_threads[chunk_addr].second;
+        if (m_latest_written_timetable_4B.count(addr) > 0 or 
+            info.word_conflict(get_word_index_in_chunk(addr), rd, warp_logical_id(shader_id, warp_id))) {
+            m_epoch_true_aborts++;
+            g_tm_global_statistics.m_n_granularity_true_aborts++;
+        } else {
+            info.inc_num_false_aborts();
+            m_epoch_false_aborts++;
+            g_tm_global_statistics.m_n_granularity_false_aborts++;
+        }
+    }
+
     if (m_latest_written_timetable_4B.count(addr) > 0) {
         assert(m_latest_read_timetable_4B.count(addr) > 0);
 	m_num_writing_threads_4B[addr].second.inc_num_aborts();
@@ -3590,6 +3990,34 @@ void logical_temporal_conflict_detector::inc_num_aborts(addr_t addr)
     }
 }
 
+// A split word only sees true conflicts. To keep the chunk's false conflict estimate alive while the 
+// false sharing persists, an access to a split word that passed is checked against the other words 
+// of the chunk, as a single chunk entry would have checked it, and counts as a false abort if it 
+// would have aborted there. 
+void logical_temporal_conflict_detector::count_split_false_abort(addr_t addr, bool rd, tm_timestamp_t warp_pts) 
+{
+    if (g_tm_options.m_logical_temporal_adaptive_granularity == false) return;
+    if (m_latest_written_timetable_4B.count(addr) == 0) return;
+    addr_t chunk_addr = get_chunk_address(addr);
+    assert(m_latest_written_timetable.count(chunk_addr) > 0);
+    assert(m_latest_read_timetable.count(chunk_addr) > 0);
+
+    tm_timestamp_t chunk_rts = m_latest_read_timetable[chunk_addr].first;
+    tm_timestamp_t chunk_wts = m_latest_written_timetable[chunk_addr].first;
+    unsigned n_words = 1 << (g_tm_options.m_logical_temporal_cd_addr_granularity_log2 - 2);
+    addr_t first_word = chunk_addr * n_words;
+    for (addr_t word = first_word; word < first_word + n_words; word++) {
+        if (word == addr or m_latest_written_timetable_4B.count(word) == 0) continue;
+        chunk_rts = std::max(chunk_rts, m_latest_read_timetable_4B[word].first);
+        chunk_wts = std::max(chunk_wts, m_latest_written_timetable_4B[word].first);
+    }
+    tm_timestamp_t chunk_pts = (rd)? chunk_wts : std::max(chunk_rts, chunk_wts);
+    if (chunk_pts > warp_pts) {
+        m_num_writing_threads[chunk_addr].second.inc_num_false_aborts();
+        g_tm_global_statistics.m_n_granularity_split_false_aborts++;
+    }
+}
+
 void logical_temporal_conflict_detector::alloc_entry(addr_t addr, unsigned index) 
 {   
     assert(g_tm_options.m_logical_temporal_cuckoo_table_multiple_granularity_enabled);
@@ -3669,6 +4097,15 @@ bool logical_temporal_conflict_detector::could_replace_4B(addr_t addr)
     assert(m_latest_written_timetable_4B.count(addr) > 0);
     assert(m_latest_read_timetable_4B.count(addr) > 0);
 
+    if (g_tm_options.m_logical_temporal_adaptive_granularity) {
+        // merge once the false conflicts have decayed well below the split limit (hysteresis), 
+        // which happens sooner as the 4B table fills up 
+        if (m_num_writing_threads_4B.count(addr) > 0 and m_num_writing_threads_4B[addr].first > 0) 
+            return false;
+        unsigned num_false_aborts = m_num_writing_threads[chunk_addr].second.get_num_false_aborts();
+        return 2 * num_false_aborts <= split_abort_limit();
+    }
+
     if (m_num_writing_threads_4B.count(addr) > 0) { 
 	unsigned num_aborts = m_num_writing_threads[chunk_addr].second.get_num_aborts();
 	unsigned num_aborts_limit = g_tm_options.m_logical_temporal_cuckoo_table_num_aborts_limit;
@@ -3678,16 +4115,61 @@ bool logical_temporal_conflict_detector::could_replace_4B(addr_t addr)
     }
 }
 
+unsigned logical_temporal_conflict_detector::get_word_index_in_chunk(addr_t addr) const 
+{
+    return addr & ((1 << (g_tm_options.m_logical_temporal_cd_addr_granularity_log2 - 2)) - 1);
+}
+
+// The number of false conflicts a chunk must see before its words get 4B entries. It is the static 
+// aborts limit while the 4B table is empty and grows as the table fills, so that under pressure 
+// only the chunks that suffer most from false sharing are split. 
+double logical_temporal_conflict_detector::split_abort_limit() const 
+{
+    double occupancy = (double)m_latest_written_timetable_4B.size() / m_capacity_4B;
+    occupancy = std::min(occupancy, 0.95);
+    return g_tm_options.m_logical_temporal_cuckoo_table_num_aborts_limit / (1.0 - occupancy);
+}
+
+bool logical_temporal_conflict_detector::split_wanted(addr_t chunk_addr) 
+{
+    assert(g_tm_options.m_logical_temporal_cuckoo_table_multiple_granularity_enabled);
+
+    if (m_num_writing_threads.count(chunk_addr) == 0) return false;
+    if (g_tm_options.m_logical_temporal_adaptive_granularity) 
+        return m_num_writing_threads[chunk_addr].second.get_num_false_aborts() > split_abort_limit();
+    unsigned num_aborts = m_num_writing_threads[chunk_addr].second.get_num_aborts();
+    return num_aborts > g_tm_options.m_logical_temporal_cuckoo_table_num_aborts_limit;
+}
+
 void logical_temporal_conflict_detector::dec_all_num_aborts() 
 {
+    bool adaptive = g_tm_options.m_logical_temporal_adaptive_granularity;
     for(auto iter = m_num_writing_threads.begin(); iter != m_num_writing_threads.end(); iter++) {
         if (iter->second.second.get_num_aborts() > 0) 
 	    iter->second.second.dec_num_aborts();
+	if (adaptive) {
+	    // the false conflict estimate decays by half every period
+	    iter->second.second.m_num_false_aborts /= 2;
+	}
     }
     for(auto iter = m_num_writing_threads_4B.begin(); iter != m_num_writing_threads_4B.end(); iter++) {
         if (iter->second.second.get_num_aborts() > 0) 
 	    iter->second.second.dec_num_aborts();
     }
+
+    if (adaptive and (m_epoch_true_aborts > 0 or m_epoch_false_aborts > 0 or 
+                      g_tm_global_statistics.m_granularity_timeline.empty() or 
+                      g_tm_global_statistics.m_granularity_timeline.back().m_split_words != m_latest_written_timetable_4B.size())) {
+        tm_global_statistics::granularity_sample sample;
+        sample.m_cycle = gpu_sim_cycle + gpu_tot_sim_cycle;
+        sample.m_chunk_entries = m_latest_written_timetable.size();
+        sample.m_split_words = m_latest_written_timetable_4B.size();
+        sample.m_true_aborts = m_epoch_true_aborts;
+        sample.m_false_aborts = m_epoch_false_aborts;
+        g_tm_global_statistics.m_granularity_timeline.push_back(sample);
+    }
+    m_epoch_true_aborts = 0;
+    m_epoch_false_aborts = 0;
 }
 
 //////////////////////////////////////////////////////////////////////////////////
@@ -3705,6 +4187,25 @@ logical_timestamp_based_tm_manager::logical_timestamp_based_tm_manager( ptx_thre
 
 void logical_timestamp_based_tm_manager::at_start() { };
 
+bool logical_timestamp_based_tm_manager::last_read_by_other_warp(addr_t waddr) const {
+    warp_logical_id last_reader = logical_temporal_conflict_detector::get_singleton().get_last_reader(waddr);
+    if (last_reader.first == -1 || last_reader.second == -1) return false;
+    return ((unsigned)last_reader.first != sid() || (unsigned)last_reader.second != wid());
+}
+
+bool logical_timestamp_based_tm_manager::is_silent_store(memory_space *mem, addr_t waddr, addr_t addr, const void *vp, int nbytes) const {
+    // once this transaction has changed the word, later stores to it stay writes
+    if (m_write_word_set.count(waddr) > 0 and m_silent_word_set.count(waddr) == 0) return false;
+
+    addr_t word_size_log2 = g_tm_options.m_word_size_log2; 
+    addr_t lo = std::max(addr, waddr << word_size_log2);
+    addr_t hi = std::min(addr + nbytes, (waddr + 1) << word_size_log2);
+    unsigned char mem_bytes[16];
+    assert(hi > lo and hi - lo <= sizeof(mem_bytes));
+    mem->read(lo, hi - lo, mem_bytes);
+    return memcmp(mem_bytes, (const unsigned char*)vp + (lo - addr), hi - lo) == 0;
+}
+
 int g_mf_stalled_uid = 0;
 
 bool logical_timestamp_based_tm_manager::at_access(memory_space *mem, bool potential_conflicting, 
@@ -3742,6 +4243,12 @@ bool logical_timestamp_based_tm_manager::at_access(memory_space *mem, bool poten
 	tm_timestamp_t data_wts = logical_temporal_conflict_detector::get_singleton().get_wts(waddr);
 	tm_timestamp_t possible_new_warp_pts = 0;
 
+	bool silent = false;
+	if (!rd and g_tm_options.m_logical_temporal_silent_store_filter) {
+	    silent = is_silent_store(mem, waddr, addr, vp, nbytes);
+	    m_store_silent[waddr] = silent;
+	}
+
 	if (g_tm_options.m_logical_temporal_use_cuckoo_table) {
             mem_access_byte_mask_t cuckoo_check_byte_mask = mf->get_cuckoo_check_byte_mask();
 	    new_addr_type block_addr = (waddr << word_size_log2) & (127ull);
@@ -3756,9 +4263,11 @@ bool logical_timestamp_based_tm_manager::at_access(memory_space *mem, bool poten
 	assert(!aborted_tx);
  
 	if (!is_owner) {
-	    if (rd) {
+	    if (rd or silent) {
 	        possible_new_warp_pts = data_wts;
-		bool raw_pass = logical_temporal_conflict_detector::get_singleton().raw_pass(waddr, data_wts, start_pts);
+		bool mask_filter_pass;
+		bool raw_pass = logical_temporal_conflict_detector::get_singleton().raw_pass(waddr, data_wts, start_pts, &mask_filter_pass);
+		if (mask_filter_pass) g_tm_global_statistics.m_n_written_mask_aborts_avoided++;
 		if (!raw_pass) {
 		    if (data_rts >= data_wts && data_rts == warp_start_pts) {
 		        warp_logical_id last_reader = logical_temporal_conflict_detector::get_singleton().get_last_reader(waddr);
@@ -3773,36 +4282,51 @@ bool logical_timestamp_based_tm_manager::at_access(memory_space *mem, bool poten
 	    } else {
 	        possible_new_warp_pts = std::max(data_rts, data_wts);
 	        if (data_rts >= data_wts && data_rts == warp_start_pts) {
-		    warp_logical_id last_reader = logical_temporal_conflict_detector::get_singleton().get_last_reader(waddr);
-		    if (last_reader.first != -1 && last_reader.second != -1) {
-		        if (last_reader.first != sid() || last_reader.second != wid())
-		            possible_new_warp_pts++;	
-		    }
+		    if (last_read_by_other_warp(waddr))
+		        possible_new_warp_pts++;	
 		}
                 m_logical_temporal_cd_metadata.update_current_pts(possible_new_warp_pts);
 	    }
+
+	    // would the store have conflicted had it been checked as a write?
+	    if (silent and !m_logical_temporal_cd_metadata.conflict_exist()) {
+	        tm_timestamp_t write_pts = std::max(data_rts, data_wts);
+	        if (data_rts >= data_wts && data_rts == warp_start_pts) {
+		    if (last_read_by_other_warp(waddr))
+		        write_pts++;
+		}
+		if (write_pts > start_pts) 
+		    g_tm_global_statistics.m_n_silent_store_aborts_avoided++;
+	    }
 	}
 
 	if (m_logical_temporal_cd_metadata.conflict_exist()) {
 	    m_violated = true;
 	    mf->set_is_aborted();
-            logical_temporal_conflict_detector::get_singleton().inc_num_aborts(waddr);
+            logical_temporal_conflict_detector::get_singleton().inc_num_aborts(waddr, rd or silent, sid(), wid());
 	    if (mf->is_write()) {
-	        if (data_rts >= data_wts)
+	        if (data_rts >= data_wts) {
 		    g_tm_global_statistics.m_n_raw_aborts++;
-		else
+		    set_abort_cause(TM_ABORT_RAW, waddr << word_size_log2, g_tm_global_statistics.tx_profile_last_pc(waddr, true)); 
+		} else {
 		    g_tm_global_statistics.m_n_waw_aborts++;
+		    set_abort_cause(TM_ABORT_WAW, waddr << word_size_log2, g_tm_global_statistics.tx_profile_last_pc(waddr, false)); 
+		}
 	    } else {
 	        g_tm_global_statistics.m_n_war_aborts++;
+	        set_abort_cause(TM_ABORT_WAR, waddr << word_size_log2, g_tm_global_statistics.tx_profile_last_pc(waddr, false)); 
 	        if (num_writing_threads > 0)
 	            g_tm_global_statistics.m_n_pending_write_raw_aborts++;
 	    }
         } else {
+	    if (!is_owner) 
+	        logical_temporal_conflict_detector::get_singleton().count_split_false_abort(waddr, rd or silent, start_pts);
 	    if (num_writing_threads > 0 && is_owner == false) {
 		assert(start_pts >= possible_new_warp_pts);
 		if (tm_req_stall_queue::get_singleton().full(mf->get_sub_partition_id(), chunk_addr)) {
 		    m_violated = true;
 		    mf->set_is_aborted();
+		    set_abort_cause(TM_ABORT_STALL_FULL, waddr << word_size_log2, g_tm_global_statistics.tx_profile_last_pc(waddr, false)); 
 		    m_logical_temporal_cd_metadata.update_current_pts(start_pts + 1);
 		} else {
 		    mf->set_is_stalled();
@@ -3850,9 +4374,22 @@ void logical_timestamp_based_tm_manager::update_logical_info(addr_t addr, bool r
     tm_timestamp_t start_pts = m_logical_temporal_cd_metadata.m_start_pts;
     
     for (addr_t waddr = base_waddr; waddr < limit_waddr; waddr++) {
-	if (rd) {
+	bool silent = false;
+	if (!rd and m_store_silent.count(waddr) > 0) {
+	    silent = m_store_silent[waddr];
+	    m_store_silent.erase(waddr);
+	}
+
+	g_tm_global_statistics.record_tx_profile_access(waddr, rd or silent, m_thread->get_pc()); 
+	if (silent) {
+	    // leaves memory unchanged: record it as a read at the tx pts
+	    logical_temporal_conflict_detector::get_singleton().update_logical_timestamp(waddr, true, start_pts, sid(), wid());
+	    m_silent_word_set.insert(waddr);
+	    g_tm_global_statistics.m_n_silent_stores++;
+	} else if (rd) {
             logical_temporal_conflict_detector::get_singleton().update_logical_timestamp(waddr, rd, start_pts, sid(), wid());
 	} else {
+	    m_silent_word_set.erase(waddr);
 	    // Inorder to avoid cyclic dependence, increase wts by 1
             logical_temporal_conflict_detector::get_singleton().inc_num_writing_threads(waddr, 1);
             logical_temporal_conflict_detector::get_singleton().update_logical_timestamp(waddr, rd, start_pts + 1, sid(), wid());
@@ -3869,12 +4406,14 @@ void logical_timestamp_based_tm_manager::at_abort() {
     if (m_n_write > 0) {
         set_is_abort_need_clean();
     }
+    m_store_silent.clear();
     m_violated = false;
 }
 
 void logical_timestamp_based_tm_manager::validate() {
     for (auto iter = m_write_word_set.begin(); iter != m_write_word_set.end(); iter++) {
         addr_t waddr = *iter;
+        if (m_silent_word_set.count(waddr) > 0) continue; // tracked as a read
         unsigned int num_writing_threads = logical_temporal_conflict_detector::get_singleton().get_num_writing_threads(waddr);
         tm_timestamp_t start_pts = m_logical_temporal_cd_metadata.m_start_pts;
 	bool is_owner = logical_temporal_conflict_detector::get_singleton().check_owner(waddr, start_pts, sid(), wid());
@@ -3916,7 +4455,17 @@ void logical_timestamp_based_tm_manager::commit_core_side() {
             w.print(stdout);
             printf("\n"); 
          }
-         w.commit();
+         if (w.get_memory_space() == m_gmem and !m_silent_word_set.empty()) {
+            // silent stores are ordered as reads: writing them back could undo a later writer 
+            unsigned word_size = g_tm_options.m_word_size; 
+            addr_t end = w.getaddr() + w.getsize(); 
+            for (addr_t a = w.getaddr(); a < end; a += word_size) {
+               if (m_silent_word_set.count(a >> g_tm_options.m_word_size_log2) == 0) 
+                  w.commit_word(a, std::min<addr_t>(word_size, end - a)); 
+            }
+         } else {
+            w.commit();
+         }
 
          #ifdef track_last_writer
          g_last_writer[w.getaddr()] = last_writer_info(m_thread_uid, m_thread_sc, m_thread_hwtid, gpu_sim_cycle + gpu_tot_sim_cycle); 
@@ -3940,10 +4489,12 @@ void logical_timestamp_based_tm_manager::commit_core_side() {
    // update statistics 
    g_tm_global_statistics.m_n_commits += 1;
    g_tm_global_statistics.dec_concurrency();
-   g_tm_global_statistics.record_commit_tx_size(m_read_word_set.size(), m_write_word_set.size(), m_access_word_set.size());
+   g_tm_global_statistics.record_commit_tx_size(m_read_word_set.size(), m_write_word_set.size(), access_word_count());
+   derive_block_sets(); 
    g_tm_global_statistics.record_tx_blockcount(m_read_block_set, m_write_block_set, m_access_block_set); 
    g_tm_global_statistics.record_raw_info(m_raw_set.size(), m_raw_access); 
    g_tm_global_statistics.m_aborts_per_transaction.add2bin(m_abort_count); 
+   g_tm_global_statistics.record_tx_profile_commit(m_tx_pc, m_read_word_set.size(), m_write_word_set.size(), gpu_sim_cycle - m_first_start_cycle); 
    g_tm_global_statistics.m_duration.add2bin(gpu_sim_cycle - m_start_cycle); 
    g_tm_global_statistics.m_duration_first_rd.add2bin(gpu_sim_cycle - m_first_read_cycle); 
    g_tm_global_statistics.m_write_buffer_footprint.add2bin(m_buffered_write_word_set.size()); 
@@ -3977,6 +4528,16 @@ void logical_timestamp_based_tm_manager::commit_addr( addr_t addr ) {
 
    const unsigned cu_word_size = 4;  // should be same as g_tm_options.m_word_size 
 
+   // a silent store holds no write ownership and is not written back: the value it stored is 
+   // either still in memory or was overwritten by a writer ordered after this transaction 
+   if (m_silent_word_set.count(addr >> g_tm_options.m_word_size_log2) > 0) {
+      if (watched()) {
+         printf("[TMM-%llu] Thd %u skips silent addr[%#08x]\n", 
+                gpu_sim_cycle + gpu_tot_sim_cycle, m_thread_uid, addr);
+      }
+      return;
+   }
+
    bool commit_done = false;
    bool clear_done = false;
    std::list<access_record>::reverse_iterator i;
@@ -29,6 +29,21 @@
 #include <algorithm> 
 #include <math.h>
 
+// reason for a transaction abort, recorded in the per-transaction profile 
+enum tm_abort_cause_t {
+   TM_ABORT_OTHER = 0,      // cause not known to the functional model (e.g. timing model abort) 
+   TM_ABORT_RAW,            // logical timestamp TM: write after a later read 
+   TM_ABORT_WAR,            // logical timestamp TM: read of data written in the logical future 
+   TM_ABORT_WAW,            // logical timestamp TM: write after a later write 
+   TM_ABORT_STALL_FULL,     // logical timestamp TM: stall queue full 
+   TM_ABORT_VALUE,          // value-based validation failed 
+   TM_ABORT_COMMITTER_WIN,  // killed by a committing transaction 
+   TM_ABORT_CU_VALIDATION,  // commit unit: read-set word failed value validation 
+   TM_ABORT_CU_CONFLICT,    // commit unit: read-set hit the write-set of an older committing transaction 
+   TM_ABORT_INTRA_WARP,     // conflict with another transaction in the same warp 
+   N_TM_ABORT_CAUSE
+};
+
 class ptx_thread_info; 
 class tm_manager_inf
 {
@@ -74,6 +89,10 @@ public:
    virtual bool has_conflict_with( tm_manager_inf * other_tx ) = 0; // detect conflict between this transaction and the other 
    virtual bool validate_all( bool useTemporalCD ) = 0; // validate entire read-set (return true if pass)
 
+   // abort attribution for -tm_tx_profile: the first cause set in an attempt is reported at abort 
+   virtual void set_abort_cause( enum tm_abort_cause_t cause, addr_t addr, address_type pc ) = 0; 
+   virtual address_type get_write_pc( addr_t addr ) const = 0; // pc of the last buffered store to addr (0 if none) 
+
    // warp-level transaction helper functions 
    virtual void set_is_warp_level() { m_is_warp_level = true; }
    virtual bool get_is_warp_level() { return m_is_warp_level; }
@@ -123,6 +142,7 @@ void tm_reg_options(option_parser_t opp);
 void tm_sample_conflict_footprint(); // called every cycle 
 void tm_dump_profile(); // called at the end of simulation 
 void tm_statistics(FILE *fout); 
+void tm_new_kernel(); // reset per-kernel profiles at kernel start 
 void tm_statistics_visualizer( gzFile visualizer_file ); 
 
 #endif
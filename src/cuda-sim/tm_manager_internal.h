@@ -35,7 +35,83 @@
 
 #define TM_MEM_BUCKET_SIZE 6 // log2(number of bytes per bucket) 
 #define CACHE_LINE_SIZE 7 // log2 (cache line size ) used to collect statistics on cache lines accessed by transactions
-typedef std::set<addr_t> addr_set_t;
+
+// Ordered set of addresses stored as a sorted vector. Transactional footprints are small and
+// mostly grow in address order, so an insert is usually an append. clear() keeps the storage, so
+// a retried transaction refills its sets without going back to the allocator. Iteration is in
+// increasing address order, like the std::set it replaces.
+class tm_addr_set {
+public:
+   typedef addr_t value_type; 
+   typedef std::vector<addr_t>::const_iterator const_iterator; 
+   typedef const_iterator iterator; 
+
+   const_iterator begin() const { return m_addrs.begin(); }
+   const_iterator end() const { return m_addrs.end(); }
+   const_iterator cbegin() const { return m_addrs.begin(); }
+   const_iterator cend() const { return m_addrs.end(); }
+   size_t size() const { return m_addrs.size(); }
+   bool empty() const { return m_addrs.empty(); }
+   void clear() { m_addrs.clear(); }
+
+   const_iterator find( addr_t addr ) const 
+   {
+      const_iterator i = std::lower_bound(m_addrs.begin(), m_addrs.end(), addr); 
+      return (i != m_addrs.end() && *i == addr)? i : m_addrs.end(); 
+   }
+   size_t count( addr_t addr ) const { return (find(addr) != end())? 1 : 0; }
+
+   std::pair<const_iterator,bool> insert( addr_t addr ) 
+   {
+      if (m_addrs.empty() || m_addrs.back() < addr) {
+         m_addrs.push_back(addr); 
+         return std::make_pair(m_addrs.end() - 1, true); 
+      }
+      std::vector<addr_t>::iterator i = std::lower_bound(m_addrs.begin(), m_addrs.end(), addr); 
+      if (*i == addr) 
+         return std::make_pair(const_iterator(i), false); 
+      i = m_addrs.insert(i, addr); 
+      return std::make_pair(const_iterator(i), true); 
+   }
+
+   // fill with the addresses of 'fine' shifted right by 'shift' bits (e.g. bytes to blocks) 
+   void assign_coarser( const tm_addr_set &fine, unsigned shift ) 
+   {
+      m_addrs.clear(); 
+      for (const_iterator i = fine.begin(); i != fine.end(); ++i) {
+         addr_t coarse = *i >> shift; 
+         if (m_addrs.empty() || m_addrs.back() != coarse) 
+            m_addrs.push_back(coarse); 
+      }
+   }
+
+   // fill with the union of two sets 
+   void assign_union( const tm_addr_set &a, const tm_addr_set &b ) 
+   {
+      m_addrs.resize(a.size() + b.size()); 
+      std::vector<addr_t>::iterator last = std::set_union(a.begin(), a.end(), b.begin(), b.end(), m_addrs.begin()); 
+      m_addrs.erase(last, m_addrs.end()); 
+   }
+
+   // number of addresses in the union of two sets, without building it 
+   static size_t union_size( const tm_addr_set &a, const tm_addr_set &b ) 
+   {
+      size_t n = 0; 
+      const_iterator i = a.begin(); 
+      const_iterator j = b.begin(); 
+      while (i != a.end() && j != b.end()) {
+         if (*i < *j) ++i; 
+         else if (*j < *i) ++j; 
+         else { ++i; ++j; }
+         n++; 
+      }
+      return n + (a.end() - i) + (b.end() - j); 
+   }
+
+private:
+   std::vector<addr_t> m_addrs; 
+};
+typedef tm_addr_set addr_set_t;
 // typedef std::set<unsigned> tuid_set_t;
 typedef std::unordered_set<unsigned> tuid_set_t;
 typedef tr1_hash_map<addr_t, int> addr_version_set_t;
@@ -67,6 +143,9 @@ public:
    virtual void commit_core_side( ); // commit a transaction on the core side 
    virtual void validate_or_crash( ); // validate a transaction and crash if it is not valid
 
+   virtual void set_abort_cause( enum tm_abort_cause_t cause, addr_t addr, address_type pc ); 
+   virtual address_type get_write_pc( addr_t addr ) const; 
+
    // detect conflict between this transaction and the other 
    virtual bool has_conflict_with( tm_manager_inf * other_tx ) {
       assert(0); // invalid for baseline transaction manager
@@ -129,8 +208,9 @@ protected:
    	addr_t getaddr(){return m_addr;}
    	unsigned getsize (){return m_nbytes;}
    	void* getvalue(){return m_bytes;}
-        bool contain_addr( addr_t addr, unsigned bytes ); 
+        bool contain_addr( addr_t addr, unsigned bytes ) const; 
         memory_space* get_memory_space() const { return m_mem; } 
+        address_type get_pc() const { return m_pc; } 
 	void commit();
 	void commit_word( addr_t addr, unsigned bytes );
         void print(FILE *fout);
@@ -142,6 +222,7 @@ protected:
 	unsigned 	m_nbytes;
 	void *		m_bytes;
 	memory_space *m_mem;
+	address_type	m_pc; // pc of the store, for abort attribution 
    };
 
    std::list<access_record> m_write_data;
@@ -156,13 +237,29 @@ protected:
       {
          m_modified = 0;
          assert( (1<<TM_MEM_BUCKET_SIZE) == 8*sizeof(unsigned long long) );
-         m_data.resize( pow(2,TM_MEM_BUCKET_SIZE) );
       }
       unsigned long long m_modified;
-      std::vector<unsigned char> m_data;
+      unsigned char m_data[1<<TM_MEM_BUCKET_SIZE];
+   };
+   // redo buffer: written buckets kept sorted by (memory space, bucket address) in one vector, 
+   // so that buffering a write allocates nothing once a retried transaction has warmed it up 
+   class tm_mem_t {
+   public:
+      tm_mem_bucket* find( memory_space *mem, unsigned bucket_addr ); 
+      tm_mem_bucket& lookup_or_insert( memory_space *mem, unsigned bucket_addr ); 
+      void clear() { m_entries.clear(); }
+   private:
+      struct entry {
+         memory_space *m_mem; 
+         unsigned m_bucket_addr; 
+         tm_mem_bucket m_bucket; 
+         bool operator<( const entry &other ) const 
+         {
+            return (m_mem != other.m_mem)? (m_mem < other.m_mem) : (m_bucket_addr < other.m_bucket_addr); 
+         }
+      };
+      std::vector<entry> m_entries; 
    };
-   typedef std::map<unsigned,tm_mem_bucket> tm_mem_hash_t;
-   typedef std::map<memory_space*, tm_mem_hash_t> tm_mem_t;
    tm_mem_t m_tm_mem;
    tm_manager * m_gmem_view_tx; 
 
@@ -176,9 +273,11 @@ protected:
    // read/write set in word (32-bit) granularity 
    addr_set_t m_read_word_set; 
    addr_set_t m_write_word_set;  // only record the potentially conflicting ones
-   addr_set_t m_access_word_set; // both read and write 
+   size_t access_word_count() const { return addr_set_t::union_size(m_read_word_set, m_write_word_set); } // both read and write 
 
-   // read/write set in block (configurable #bytes) granularity 
+   // read/write set in block (configurable #bytes) granularity, derived from the byte sets 
+   // by derive_block_sets() when needed 
+   void derive_block_sets(); 
    addr_set_t m_read_block_set; 
    addr_set_t m_write_block_set; 
    addr_set_t m_access_block_set; // both read and write 
@@ -206,6 +305,13 @@ protected:
    unsigned long long m_start_cycle; // when the transaction called txbegin()
    unsigned long long m_first_read_cycle; // when the transaction first load from memory 
 
+   // per-transaction profile 
+   address_type m_tx_pc; // pc of the outermost tx_begin 
+   unsigned long long m_first_start_cycle; // start of first attempt, not reset on abort 
+   enum tm_abort_cause_t m_abort_cause; // first conflict observed in the current attempt 
+   addr_t m_abort_addr; 
+   address_type m_abort_pc; // pc of the conflicting access (from the other transaction if known) 
+
    // full access log - all conflictable read and all buffered writes 
    std::list<access_record> m_access_log;
    void write_access_log(); 
@@ -263,6 +369,10 @@ public:
 
    void dump(FILE *fp);
 
+   // last written times outlive a kernel, they are saved in a checkpoint 
+   void save_checkpoint(FILE *fp) const; 
+   void load_checkpoint(FILE *fp); 
+
    static temporal_conflict_detector& get_singleton(); 
 
 protected: 
@@ -316,12 +426,15 @@ protected:
    virtual void at_commit_success(); // after conflicts are resolved 
 
    void validate(); // perform conflict detection 
+   bool read_set_word_valid( addr_t waddr, unsigned int value, unsigned int &mem_value ); 
 
    // TM metadata 
    typedef tr1_hash_map<addr_t, unsigned int> addr_value_t;
    addr_value_t m_read_set_value; 
    bool m_violated; // true when this transaction is operating on inconsistent data 
    memory_space *m_gmem; // assume this is global memory 
+   // global memory write clock at which the whole read-set was last known to match memory 
+   unsigned long long m_validated_clock; 
    unsigned long long m_last_validation; // when was this transaction last validated 
    addr_set_t m_committed_set;
 
@@ -377,12 +490,15 @@ struct dynamic_granularity_info {
     unsigned int m_num_aborts;
 };
 
+typedef std::pair<int, int> warp_logical_id;
+typedef std::pair<tm_timestamp_t, warp_logical_id> tm_logical_timestamp_t;
+
 struct additional_write_info {
     additional_write_info();
     void reset();
     void set_num_writing_decreased() { m_num_writing_decreased = true; }
     void set_old_wts(tm_timestamp_t old_wts) { m_old_wts = old_wts; }
-    bool raw_pass(addr_t addr, tm_timestamp_t req_timestamp);
+    bool raw_pass(addr_t addr, tm_timestamp_t req_timestamp, bool *mask_filter_pass = NULL);
     unsigned get_word_index(addr_t addr);
     void set_written_word_mask(addr_t addr);
     void inc_num_aborts() { m_num_aborts++; }
@@ -392,17 +508,24 @@ struct additional_write_info {
     bool splited(unsigned index);
     void set_split_mask(unsigned index);
     void clear_split_mask(unsigned index);
+    // adaptive granularity: words of the chunk touched by the accesses that set its current rts/wts 
+    // (with the warp that touched them), and an estimate of the aborts that no word-grained entry 
+    // would have caused 
+    void record_word_access(unsigned index, bool rd, tm_timestamp_t new_time, tm_timestamp_t old_time, warp_logical_id warp);
+    bool word_conflict(unsigned index, bool rd, warp_logical_id warp) const;
+    void inc_num_false_aborts() { m_num_false_aborts++; }
+    unsigned get_num_false_aborts() const { return m_num_false_aborts; }
 
     bool m_num_writing_decreased;
     tm_timestamp_t m_old_wts;
     std::vector<bool> m_written_word_mask;
     unsigned m_num_aborts;
     std::vector<bool> m_split_mask;
+    std::vector<warp_logical_id> m_rts_word_warp;  // (-1,-1) = not read at rts, (-2,-2) = read by several warps 
+    std::vector<warp_logical_id> m_wts_word_warp;  // same for the writes at wts 
+    unsigned m_num_false_aborts;
 };
 
-typedef std::pair<int, int> warp_logical_id;
-typedef std::pair<tm_timestamp_t, warp_logical_id> tm_logical_timestamp_t;
-
 class logical_temporal_conflict_detector
 {
 public: 
@@ -428,7 +551,9 @@ public:
 
    bool is_splited(addr_t addr);
    bool is_splited(addr_t addr, unsigned index);
-   void inc_num_aborts(addr_t addr);
+   bool split_wanted(addr_t chunk_addr);
+   void inc_num_aborts(addr_t addr, bool rd, unsigned int shader_id, unsigned int warp_id);
+   void count_split_false_abort(addr_t addr, bool rd, tm_timestamp_t warp_pts);
    unsigned get_num_aborts(addr_t addr);
    unsigned get_num_aborts_4B(addr_t addr);
    void alloc_entry(addr_t addr, unsigned index);
@@ -465,7 +590,8 @@ public:
   
    void num_tm_cuckoo_cycles(mem_fetch *mf);
 
-   bool raw_pass(addr_t addr, tm_timestamp_t wts, tm_timestamp_t warp_pts);
+   // mask_filter_pass is set if the pass was only possible because of -tm_logical_temporal_written_mask_filter 
+   bool raw_pass(addr_t addr, tm_timestamp_t wts, tm_timestamp_t warp_pts, bool *mask_filter_pass = NULL);
 
    void dump(FILE *fp);
    
@@ -495,6 +621,13 @@ protected:
    latest_read_logical_time_t m_latest_read_timetable_4B;
    pending_num_writing_threads m_num_writing_threads_4B;
 
+   // adaptive granularity controller (-tm_logical_temporal_adaptive_granularity) 
+   unsigned get_word_index_in_chunk(addr_t addr) const;
+   double split_abort_limit() const;
+   unsigned m_capacity_4B;
+   unsigned m_epoch_true_aborts;
+   unsigned m_epoch_false_aborts;
+
    std::vector<tm_timestamp_t> m_warp_pts_start;       // pts at which the Tx start
    std::vector<tm_timestamp_t> m_warp_pts_current;     // latest Tx pts
    std::vector<tm_timestamp_t> m_largest_pts;
@@ -518,7 +651,7 @@ public:
    virtual bool has_conflict_with( tm_manager_inf * other_tx ); 
 
    virtual void update_logical_info(addr_t addr, bool rd, int nbytes, memory_space_t space);
-   virtual void clear_write_data() { m_write_data.clear(); }
+   virtual void clear_write_data() { m_write_data.clear(); m_silent_word_set.clear(); }
 
    void dump_write_data();
 protected:
@@ -535,6 +668,15 @@ protected:
    bool m_violated; 
    addr_set_t m_committed_set;
    addr_set_t m_cleared_set;
+
+   // silent store filtering: a store of the value global memory already holds is ordered like a read
+   // at the transaction's pts and never written back, so it neither advances wts nor blocks other writers
+   bool is_silent_store( memory_space *mem, addr_t waddr, addr_t addr, const void *vp, int nbytes ) const;
+   std::unordered_map<addr_t, bool> m_store_silent;  // per word decision of the store in flight, consumed by update_logical_info
+   std::unordered_set<addr_t> m_silent_word_set;     // words this transaction has only stored silently
+
+   // is the word's rts set by a read of another warp?
+   bool last_read_by_other_warp( addr_t waddr ) const;
    
    class logical_temporal_cd_metadata {
    public:
@@ -574,6 +716,7 @@ public:
    bool m_lazy_conflict_detection; 
    bool m_check_bloomfilter_correctness; 
    bool m_abort_profile; 
+   bool m_tx_profile; 
 
    bool m_use_ring_tm; 
    bool m_ring_tm_eager_cd; 
@@ -600,6 +743,7 @@ public:
    unsigned m_temporal_bloomfilter_n_hash;  
    unsigned m_temporal_cd_addr_granularity; 
    unsigned m_temporal_cd_addr_granularity_log2; 
+   bool m_functional_warmup_temporal_cd; // functionally committed writes update the temporal conflict detector 
 
    bool m_use_logical_timestamp_based_tm;
    bool m_logical_temporal_use_cuckoo_table;
@@ -628,6 +772,8 @@ public:
 
    bool m_logical_temporal_cuckoo_table_check_raw;
    unsigned m_logical_temporal_cuckoo_table_check_raw_granularity;
+   bool m_logical_temporal_written_mask_filter;
+   bool m_logical_temporal_silent_store_filter;
 
    unsigned m_logical_timestamp_tm_stall_queue_size;
    unsigned m_logical_timestamp_tm_stall_queue_entry_size;
@@ -637,6 +783,7 @@ public:
    unsigned m_logical_temporal_cuckoo_table_num_aborts_limit;
    unsigned m_logical_temporal_cuckoo_table_num_aborts_limit_4B;
    unsigned m_logical_temporal_cuckoo_table_num_aborts_dec_period;
+   bool m_logical_temporal_adaptive_granularity;
 
    // Parameters for LSU HPCA2016 Early Abort paper
    bool m_lsu_hpca_enabled;
@@ -664,6 +811,71 @@ struct conflict_set {
 	tuid_set_t m_tuids_have_written;
 };
 
+// readers and writers of a single byte, same conflict rules as conflict_set 
+struct conflict_byte_state {
+   unsigned m_n_readers; 
+   unsigned m_n_writers; 
+   bool empty() const { return m_n_readers == 0 && m_n_writers == 0; }
+   bool conflict() const { return m_n_writers > 1 || (m_n_writers == 1 && m_n_readers > 0); }
+   bool read_only() const { return m_n_readers > 0 && m_n_writers == 0; }
+   bool write_only() const { return m_n_readers == 0 && m_n_writers > 0; }
+};
+
+// Transactional accessors of one aligned word, replacing a hash map entry with two tuid sets 
+// per byte. Each transaction that touched the word keeps a mask of the bytes it has read and 
+// of the bytes it has written; the first few are stored in place. 
+class conflict_word {
+public:
+   static const unsigned N_BYTES_LOG2 = 2; 
+   static const unsigned N_BYTES = 1 << N_BYTES_LOG2; 
+
+   struct accessor {
+      unsigned m_tuid; 
+      unsigned char m_read_mask; 
+      unsigned char m_write_mask; 
+   };
+
+   conflict_word() : m_present_mask(0), m_n_accessors(0) { }
+
+   unsigned size() const { return m_n_accessors; }
+   accessor& at( unsigned i ) { return (i < N_INLINE)? m_inline[i] : m_more[i - N_INLINE]; }
+   const accessor& at( unsigned i ) const { return (i < N_INLINE)? m_inline[i] : m_more[i - N_INLINE]; }
+   accessor* find( unsigned tuid ); 
+   accessor& find_or_add( unsigned tuid ); 
+   void remove_idle_accessors(); 
+
+   conflict_byte_state byte_state( unsigned char byte_mask ) const; 
+   void get_conflict_set( unsigned char byte_mask, conflict_set &cs ) const; 
+
+   // bytes with an entry in the conflict table (including bytes whose sets became empty 
+   // but have not been removed yet) 
+   unsigned char m_present_mask; 
+
+private:
+   static const unsigned N_INLINE = 2; 
+   unsigned m_n_accessors; 
+   accessor m_inline[N_INLINE]; 
+   std::vector<accessor> m_more; 
+};
+
+// profile of a static transaction, identified by the pc of its tx_begin 
+struct tm_tx_profile_entry {
+   unsigned long long m_n_commits; 
+   unsigned long long m_n_aborts; 
+   unsigned long long m_n_abort_cause[N_TM_ABORT_CAUSE]; 
+   unsigned long long m_tot_read_size; // words, committed transactions only 
+   unsigned long long m_tot_write_size; 
+   unsigned long long m_tot_cycles; // from first tx_begin to commit, including retries 
+   std::map<addr_t, unsigned> m_abort_addr; // conflicting addresses 
+   std::map<address_type, unsigned> m_abort_pc; // pc of the access this transaction conflicted with 
+
+   tm_tx_profile_entry() 
+      : m_n_commits(0), m_n_aborts(0), m_tot_read_size(0), m_tot_write_size(0), m_tot_cycles(0) 
+   { 
+      for (unsigned c = 0; c < N_TM_ABORT_CAUSE; c++) m_n_abort_cause[c] = 0; 
+   }
+};
+
 class tm_global_statistics {
 public:
     unsigned long long m_n_aborts;
@@ -762,6 +974,18 @@ public:
     void record_abort_at_address(addr_t addr, const conflict_set& cs); 
     void dump_abort_profile(FILE *csv); 
 
+    // per-transaction (tx_begin pc) profile 
+    std::map<address_type, tm_tx_profile_entry> m_tx_profile; 
+    void record_tx_profile_commit(address_type tx_pc, size_t read_size, size_t write_size, unsigned long long cycles); 
+    void record_tx_profile_abort(address_type tx_pc, enum tm_abort_cause_t cause, addr_t addr, address_type conflict_pc); 
+    void print_tx_profile(FILE *fout); 
+    void clear_tx_profile(); // at kernel start 
+    // pc of the last transactional read / committed or buffered write to each word 
+    tr1_hash_map<addr_t, address_type> m_tx_profile_read_pc; 
+    tr1_hash_map<addr_t, address_type> m_tx_profile_write_pc; 
+    void record_tx_profile_access(addr_t waddr, bool rd, address_type pc); 
+    address_type tx_profile_last_pc(addr_t waddr, bool rd) const; 
+
     pow2_histogram m_n_reread;
     unsigned m_n_reread_violation; 
 
@@ -781,6 +1005,13 @@ public:
     // intra-warp conflict detected and aborted 
     unsigned long long m_n_intra_warp_detected_conflicts; 
     unsigned long long m_n_vcd_tcd_mismatch; 
+    // read-set words validated by their memory block version instead of by value 
+    unsigned long long m_n_version_validated; 
+    // stores that left memory unchanged and were tracked as reads (-tm_logical_temporal_silent_store_filter) 
+    unsigned long long m_n_silent_stores; 
+    unsigned long long m_n_silent_store_aborts_avoided; 
+    // reads that passed on a word of the chunk no pending writer has written 
+    unsigned long long m_n_written_mask_aborts_avoided; 
 
     // number of read-after-write access between threads within a warp 
     pow2_histogram m_n_warp_level_raw;
@@ -831,6 +1062,20 @@ public:
 
     unsigned long long m_tot_cuckoo_table_splited_addr;
 
+    // adaptive granularity: aborts on a word the conflicting chunk accesses touched (true) or not (false), 
+    // and the granularity distribution at the end of every abort decrement period 
+    unsigned long long m_n_granularity_true_aborts;
+    unsigned long long m_n_granularity_false_aborts;
+    unsigned long long m_n_granularity_split_false_aborts; // would-be false aborts avoided by split words 
+    struct granularity_sample {
+        unsigned long long m_cycle;
+        unsigned m_chunk_entries;
+        unsigned m_split_words;
+        unsigned m_true_aborts;
+        unsigned m_false_aborts;
+    };
+    std::vector<granularity_sample> m_granularity_timeline;
+
     unsigned long long m_largest_pts;
 
     // metrics for LSU HPCA2016 Early Abort paper
@@ -961,6 +1206,10 @@ public:
         m_regs_read_max(1, "m_regs_read_max"), 
         m_n_intra_warp_detected_conflicts(0), 
         m_n_vcd_tcd_mismatch(0), 
+        m_n_version_validated(0), 
+        m_n_silent_stores(0), 
+        m_n_silent_store_aborts_avoided(0), 
+        m_n_written_mask_aborts_avoided(0), 
         m_n_warp_level_raw("tm_n_warp_level_raw"),
 	m_icnt_L2_queue_occupancy(1, "m_icnt_L2_queue_occupancy"),
 	m_L2_icnt_queue_occupancy(1, "m_L2_icnt_queue_occupancy"),
@@ -996,6 +1245,9 @@ public:
 	m_num_cuckoo_table_aborts_per_addr(1, "tm_num_cuckoo_table_aborts_per_addr"),
 	m_tot_cuckoo_table_aborts_per_addr(0),
 	m_tot_cuckoo_table_splited_addr(0),
+	m_n_granularity_true_aborts(0),
+	m_n_granularity_false_aborts(0),
+	m_n_granularity_split_false_aborts(0),
 	m_largest_pts(0),
 	m_tot_early_aborts(0),
 	m_tot_early_abort_messages(0),
@@ -1096,7 +1348,7 @@ protected:
 
 class tm_global_state {
 public:	
-   tm_global_state() : m_conflict_footprint(0), m_readonly_footprint(0), m_writeonly_footprint(0) { } 
+   tm_global_state() : m_n_mem_bytes(0), m_conflict_footprint(0), m_readonly_footprint(0), m_writeonly_footprint(0) { } 
 	tuid_set_t mem_access( unsigned tuid, bool rd, unsigned addr, unsigned nbytes );
 	void remove_tuid( unsigned tuid, const addr_set_t &read_set, const addr_set_t &write_set );
 	void register_thread( ptx_thread_info *thrd );
@@ -1117,8 +1369,15 @@ public:
 
    int conflict_footprint() const { return m_conflict_footprint; }
 private:
-	typedef tr1_hash_map<unsigned,conflict_set> conflict_mem_t;
-	conflict_mem_t m_mem;
+   // footprint bookkeeping for one byte whose accessor sets have changed 
+   void track_byte_change( const conflict_byte_state &before, const conflict_byte_state &after, bool retain_conflict_max ); 
+   // marks a byte as present in the conflict table, returns its word 
+   conflict_word& touch_byte( unsigned addr ); 
+   void remove_tuid_accesses( unsigned tuid, const addr_set_t &access_set, bool rd ); 
+
+	typedef tr1_hash_map<unsigned,conflict_word> conflict_mem_t;
+	conflict_mem_t m_mem; // indexed by word address 
+   size_t m_n_mem_bytes; // bytes present in m_mem 
    int m_conflict_footprint; 
    int m_readonly_footprint; 
    int m_writeonly_footprint; 
@@ -0,0 +1,89 @@
+// Copyright (c) 2009-2011, Tor M. Aamodt
+// The University of British Columbia
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// Redistributions of source code must retain the above copyright notice, this
+// list of conditions and the following disclaimer.
+// Redistributions in binary form must reproduce the above copyright notice, this
+// list of conditions and the following disclaimer in the documentation and/or
+// other materials provided with the distribution.
+// Neither the name of The University of British Columbia nor the names of its
+// contributors may be used to endorse or promote products derived from this
+// software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+// ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+// WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+// OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+#ifndef CHECKPOINT_H
+#define CHECKPOINT_H
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+// Simulator checkpoints are taken at kernel launch boundaries, when no request is in flight.
+// Each unit saves its persistent state with save_checkpoint() and reads it back in the same
+// order with load_checkpoint(). Sections are tagged so that a checkpoint taken with a
+// different configuration (or a unit saving/loading different state) is caught on restore.
+
+inline void ckpt_write_raw( FILE *fp, const void *data, size_t nbytes )
+{
+   if (fwrite(data, 1, nbytes, fp) != nbytes) {
+      printf("GPGPU-Sim uArch: ERROR ** failed writing checkpoint\n");
+      abort();
+   }
+}
+
+inline void ckpt_read_raw( FILE *fp, void *data, size_t nbytes )
+{
+   if (fread(data, 1, nbytes, fp) != nbytes) {
+      printf("GPGPU-Sim uArch: ERROR ** checkpoint is truncated\n");
+      abort();
+   }
+}
+
+template<class T> void ckpt_write( FILE *fp, const T &value ) { ckpt_write_raw(fp, &value, sizeof(T)); }
+template<class T> void ckpt_read( FILE *fp, T &value ) { ckpt_read_raw(fp, &value, sizeof(T)); }
+
+inline void ckpt_write_tag( FILE *fp, const char *tag )
+{
+   char buf[16];
+   memset(buf, 0, sizeof(buf));
+   strncpy(buf, tag, sizeof(buf) - 1);
+   ckpt_write_raw(fp, buf, sizeof(buf));
+}
+
+inline void ckpt_check_tag( FILE *fp, const char *tag )
+{
+   char buf[16];
+   ckpt_read_raw(fp, buf, sizeof(buf));
+   if (strncmp(buf, tag, sizeof(buf) - 1) != 0) {
+      printf("GPGPU-Sim uArch: ERROR ** checkpoint section '%.15s' found where '%s' is expected "
+             "(checkpoint taken with a different configuration?)\n", buf, tag);
+      abort();
+   }
+}
+
+// a value the restoring configuration must match
+template<class T> void ckpt_check( FILE *fp, const T &expected, const char *what )
+{
+   T value;
+   ckpt_read(fp, value);
+   if (value != expected) {
+      printf("GPGPU-Sim uArch: ERROR ** checkpoint %s does not match the simulated configuration\n", what);
+      abort();
+   }
+}
+
+#endif
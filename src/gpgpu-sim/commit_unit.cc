@@ -1311,10 +1311,10 @@ warp_commit_entry & commit_unit::get_warp_commit_entry( int core_id, int warp_id
 // return the warp_commit_entry corresponding to the core/warp of the message 
 warp_commit_entry & commit_unit::get_warp_commit_entry_for_msg( mem_fetch *input_msg, unsigned time )
 {
-   std::list<mem_fetch*>& packets = input_msg->get_coalesced_packet_list(); 
+   const coalesced_packet_list& packets = input_msg->get_coalesced_packet_list(); 
    assert(packets.size() > 0); 
 
-   std::list<mem_fetch*>::const_iterator msg = packets.begin(); 
+   coalesced_packet_list::const_iterator msg = packets.begin(); 
    int sid = (*msg)->get_sid(); 
    int wid = (*msg)->get_wid(); 
 
@@ -1394,7 +1394,7 @@ void commit_unit::process_coalesced_input_parallel( mem_fetch *input_msg, unsign
    case TX_WRITE_SET: {
          // estimate coalescing ratio 
          if (input_msg->partial_processed_packet() == false) {
-            std::list<mem_fetch*>& packets = input_msg->get_coalesced_packet_list(); 
+            const coalesced_packet_list& packets = input_msg->get_coalesced_packet_list(); 
             unsigned raw_access_count = packets.size(); 
             unsigned coalesced_access_count = num_coalesced_accesses(packets); 
             if (access_type == TX_READ_SET) {
@@ -1490,13 +1490,13 @@ void commit_unit::process_coalesced_input_parallel( mem_fetch *input_msg, unsign
 }
 
 // return the number of coalesced access generated from a given group of packets 
-unsigned commit_unit::num_coalesced_accesses( const std::list<mem_fetch*>& packets ) 
+unsigned commit_unit::num_coalesced_accesses( const coalesced_packet_list& packets ) 
 {
    const new_addr_type block_size = 128; 
    std::map<new_addr_type, unsigned> accessed_blocks; 
 
-   std::list<mem_fetch*>::const_iterator iPacket; 
-   for (iPacket = packets.cbegin(); iPacket != packets.cend(); ++iPacket) {
+   coalesced_packet_list::const_iterator iPacket; 
+   for (iPacket = packets.begin(); iPacket != packets.end(); ++iPacket) {
       new_addr_type block_addr = (*iPacket)->get_addr() & ~(block_size-1); 
       accessed_blocks[block_addr] += 1; 
    }
@@ -2409,6 +2409,16 @@ bool commit_unit::check_conflict_for_read(int commit_id, new_addr_type read_addr
    return conflict_detect; 
 }
 
+// record in the aborting transaction's profile the store of the older transaction it conflicts with 
+void commit_unit::attribute_conflict_abort(commit_entry &victim, commit_entry &winner, new_addr_type addr)
+{
+   tm_manager_inf *victim_tm = victim.get_tm_manager(); 
+   if (victim_tm == NULL) return; // only known with timing_mode_vb_commit 
+   tm_manager_inf *winner_tm = winner.get_tm_manager(); 
+   address_type pc = (winner_tm != NULL)? winner_tm->get_write_pc(addr) : 0; 
+   victim_tm->set_abort_cause(TM_ABORT_CU_CONFLICT, addr, pc); 
+}
+
 // check for conflict between a incoming write and read set of the younger transactions 
 void commit_unit::check_conflict_for_write(int commit_id, new_addr_type write_addr)
 {
@@ -2426,6 +2436,7 @@ void commit_unit::check_conflict_for_write(int commit_id, new_addr_type write_ad
          if (g_cu_options.m_fail_at_revalidation) {
             if (not writer_failed) {
                ce.set_fail(); // just fail the transaction, do not bother doing revalidation 
+               attribute_conflict_abort(ce, writing_ce, write_addr); 
                if (ce.get_state() == PASS) 
                   ce.set_state(FAIL); 
             }
@@ -2542,6 +2553,7 @@ void commit_unit::process_input( mem_fetch *mf, unsigned time )
             if (check_conflict_for_read(commit_id, addr) == true) {
                if (g_cu_options.m_fail_at_revalidation) {
                   ce.set_fail(); // just fail the transaction, do not bother doing revalidation
+                  attribute_conflict_abort(ce, get_commit_entry(ce.get_youngest_conflicting_commit_id()), addr); 
                } else {
                   ce.set_revalidate(true);
                }
@@ -3497,6 +3509,7 @@ void commit_unit::broadcast_newly_inserted_addr() {
     extern gpgpu_sim *g_the_gpu;
     unsigned num_shader = g_the_gpu->get_config().shader_config().num_shader();
     if (m_newly_inserted_addr_rd.size() >0){
+        mem_fetch *carrier = NULL;
         for (unsigned sid = 0; sid < num_shader; sid++) {
             unsigned tpc = g_the_gpu->get_config().shader_config().sid_to_cluster(sid);
 	    // Idealize the packet size as TX_PACKET_SIZE, otherwise simulation cannnot be done
@@ -3506,7 +3519,7 @@ void commit_unit::broadcast_newly_inserted_addr() {
             r->set_early_abort_inserted();
             r->set_type(NEWLY_INSERTED_ADDR);
             r->set_early_abort_addr_set(m_newly_inserted_addr_rd);
-            m_response_queue.push_back(r);
+            queue_broadcast_packet(m_response_queue, carrier, r);
 	    g_tm_global_statistics.m_tot_early_abort_messages++;
         }
 	g_tm_global_statistics.m_num_newly_inserted_addr.add2bin(m_newly_inserted_addr_rd.size());
@@ -3514,6 +3527,7 @@ void commit_unit::broadcast_newly_inserted_addr() {
 	m_newly_inserted_addr_rd.clear();
     }
     if (m_newly_inserted_addr_wr.size() >0){
+        mem_fetch *carrier = NULL;
         for (unsigned sid = 0; sid < num_shader; sid++) {
             unsigned tpc = g_the_gpu->get_config().shader_config().sid_to_cluster(sid);
 	    // Idealize the packet size as TX_PACKET_SIZE, otherwise simulation cannnot be done
@@ -3522,7 +3536,7 @@ void commit_unit::broadcast_newly_inserted_addr() {
             r->set_early_abort_inserted();
             r->set_type(NEWLY_INSERTED_ADDR);
             r->set_early_abort_addr_set(m_newly_inserted_addr_wr);
-            m_response_queue.push_back(r);
+            queue_broadcast_packet(m_response_queue, carrier, r);
 	    g_tm_global_statistics.m_tot_early_abort_messages++;
         }
 	g_tm_global_statistics.m_num_newly_inserted_addr.add2bin(m_newly_inserted_addr_wr.size());
@@ -3535,6 +3549,7 @@ void commit_unit::broadcast_removed_addr() {
     extern gpgpu_sim *g_the_gpu;
     unsigned num_shader = g_the_gpu->get_config().shader_config().num_shader();
     if (m_removed_addr_rd.size() >0){
+        mem_fetch *carrier = NULL;
         for (unsigned sid = 0; sid < num_shader; sid++) {
             unsigned tpc = g_the_gpu->get_config().shader_config().sid_to_cluster(sid);
 	    // Idealize the packet size as TX_PACKET_SIZE, otherwise simulation cannnot be done
@@ -3543,7 +3558,7 @@ void commit_unit::broadcast_removed_addr() {
             r->set_early_abort_read();
             r->set_type(REMOVED_ADDR);
             r->set_early_abort_addr_set(m_removed_addr_rd);
-            m_response_queue.push_back(r);
+            queue_broadcast_packet(m_response_queue, carrier, r);
 	    g_tm_global_statistics.m_tot_early_abort_messages++;
         }
 	g_tm_global_statistics.m_num_removed_addr.add2bin(m_removed_addr_rd.size());
@@ -3551,6 +3566,7 @@ void commit_unit::broadcast_removed_addr() {
 	m_removed_addr_rd.clear();
     }
     if (m_removed_addr_wr.size() >0){
+        mem_fetch *carrier = NULL;
         for (unsigned sid = 0; sid < num_shader; sid++) {
             unsigned tpc = g_the_gpu->get_config().shader_config().sid_to_cluster(sid);
 	    // Idealize the packet size as TX_PACKET_SIZE, otherwise simulation cannnot be done
@@ -3558,7 +3574,7 @@ void commit_unit::broadcast_removed_addr() {
             mem_fetch *r = new mem_fetch( mem_access_t(TX_MSG,0xDEADBEEF,0,false),NULL,TX_PACKET_SIZE,0,sid,tpc,m_memory_config );
             r->set_type(REMOVED_ADDR);
             r->set_early_abort_addr_set(m_removed_addr_wr);
-            m_response_queue.push_back(r);
+            queue_broadcast_packet(m_response_queue, carrier, r);
 	    g_tm_global_statistics.m_tot_early_abort_messages++;
         }
 	g_tm_global_statistics.m_num_removed_addr.add2bin(m_removed_addr_wr.size());
@@ -578,7 +578,9 @@ protected:
     bool check_conflict_for_read(int commit_id, new_addr_type read_addr);
     // check for conflict between a incoming write and read set of the younger transactions 
     // if detected, set revalidate flag of the younger transactions
-    void check_conflict_for_write(int commit_id, new_addr_type write_addr); 
+    void check_conflict_for_write(int commit_id, new_addr_type write_addr);
+    // record the winner's conflicting store in the aborting transaction's profile 
+    void attribute_conflict_abort(commit_entry &victim, commit_entry &winner, new_addr_type addr); 
     // send a mem_fetch to L2 via the ROP path for validation or commit write
     void send_to_L2(unsigned long long time, commit_unit::cu_mem_acc mem_op);
     // get current size of the commit unit
@@ -594,7 +596,7 @@ protected:
     // process coalesced input messages in parallel 
     void process_coalesced_input_parallel( mem_fetch *input_msg, unsigned time );
     // return the number of coalesced access generated from a given group of packets 
-    unsigned num_coalesced_accesses( const std::list<mem_fetch*>& packets ); 
+    unsigned num_coalesced_accesses( const coalesced_packet_list& packets ); 
 
     // process a scalar validation operation returned from L2 cache 
     void process_validation_op_reply(mem_fetch *mf, const cu_mem_acc &mem_op, unsigned time);
@@ -261,8 +261,8 @@ auto cuckoo_model_multiple_granularity::lookup(key_t key, std::vector<bool> chec
     ticks_t ticks = 0;
     success_t cuckoo_model_lookup_success = m_cuckoo_model.lookup(key);
     ticks += cuckoo_model_lookup_success.second;
-    unsigned num_aborts = logical_temporal_conflict_detector::get_singleton().get_num_aborts(key);
     if (cuckoo_model_lookup_success.first) {
+        bool split_wanted = logical_temporal_conflict_detector::get_singleton().split_wanted(key);
         bool is_splited = logical_temporal_conflict_detector::get_singleton().is_splited(key);
         bool cuckoo_model_4B_full = m_cuckoo_model_4B.almost_full();
         if (is_splited) {
@@ -280,7 +280,7 @@ auto cuckoo_model_multiple_granularity::lookup(key_t key, std::vector<bool> chec
                            m_cuckoo_model_4B.remove(word_key);
                            logical_temporal_conflict_detector::get_singleton().merge_entry(word_key, i/4);
                        } 
-                   } else if (num_aborts > m_num_aborts_limit and !cuckoo_model_4B_full) {
+                   } else if (split_wanted and !cuckoo_model_4B_full) {
                        bool evict = false;
                        unsigned evict_key = 0;
                        success_t cuckoo_model_4B_insert_success = m_cuckoo_model_4B.insert(word_key, evict, evict_key);
@@ -300,7 +300,7 @@ auto cuckoo_model_multiple_granularity::lookup(key_t key, std::vector<bool> chec
                 } 
             }
         } else {
-            if (num_aborts > m_num_aborts_limit and !cuckoo_model_4B_full) {
+            if (split_wanted and !cuckoo_model_4B_full) {
                 g_tm_global_statistics.m_tot_cuckoo_table_splited_addr++;
                 for (unsigned i = 0; i < m_granularity; i += 4) {
                     bool need_check = check_byte_mask[i];
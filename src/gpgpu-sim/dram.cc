@@ -33,6 +33,8 @@
 #include "dram_sched.h"
 #include "mem_fetch.h"
 #include "l2cache.h"
+#include "checkpoint.h"
+#include <algorithm>
 
 #ifdef DRAM_VERIFY
 int PRINT_CYCLE = 0;
@@ -420,6 +422,109 @@ void dram_t::cycle()
 #endif
 }
 
+bool dram_t::idle() const
+{
+   if (que_length() || !mrqq->empty() || !returnq->empty() || rwq->get_n_element()) 
+      return false;
+   for (unsigned i=0;i<m_config->nbk;i++) {
+      if (bk[i]->mrq) 
+         return false;
+   }
+   return true;
+}
+
+#define DECN2ZERO(x,n) x = ((x) > (n))? ((x)-(n)) : 0;
+
+// same effect as n_cycles calls to cycle() on an idle channel: 
+// nothing issues, the timing constraints count down and the channel 
+// counts as active for as long as any of them is still pending 
+void dram_t::fast_forward( unsigned n_cycles )
+{
+   assert(idle());
+
+   // rwq only holds delay slots: cycling through it once restores its steady state
+   unsigned rwq_length = rwq->get_length();
+   for (unsigned i=0;i<n_cycles && i<rwq_length;i++) 
+      rwq->pop();
+
+   unsigned pending_cycles = std::max(std::max(CCDc, RRDc), std::max(RTWc, WTRc));
+   for (unsigned j=0;j<m_config->nbk;j++) {
+      pending_cycles = std::max(pending_cycles, std::max(bk[j]->RCDc, bk[j]->RASc));
+      pending_cycles = std::max(pending_cycles, std::max(bk[j]->RCc, std::max(bk[j]->RPc, bk[j]->RCDWRc)));
+      bk[j]->n_idle += n_cycles;
+   }
+   unsigned active_cycles = std::min(n_cycles, pending_cycles);
+   n_activity += active_cycles;
+   n_activity_partial += active_cycles;
+   n_nop += n_cycles;
+   n_nop_partial += n_cycles;
+   n_cmd += n_cycles;
+   n_cmd_partial += n_cycles;
+
+   DECN2ZERO(RRDc, n_cycles);
+   DECN2ZERO(CCDc, n_cycles);
+   DECN2ZERO(RTWc, n_cycles);
+   DECN2ZERO(WTRc, n_cycles);
+   for (unsigned j=0;j<m_config->nbk;j++) {
+      DECN2ZERO(bk[j]->RCDc, n_cycles);
+      DECN2ZERO(bk[j]->RASc, n_cycles);
+      DECN2ZERO(bk[j]->RCc, n_cycles);
+      DECN2ZERO(bk[j]->RPc, n_cycles);
+      DECN2ZERO(bk[j]->RCDWRc, n_cycles);
+      DECN2ZERO(bk[j]->WTPc, n_cycles);
+      DECN2ZERO(bk[j]->RTPc, n_cycles);
+   }
+   for (unsigned j=0; j<m_config->nbkgrp; j++) {
+      DECN2ZERO(bkgrp[j]->CCDLc, n_cycles);
+      DECN2ZERO(bkgrp[j]->RTPLc, n_cycles);
+   }
+}
+
+void dram_t::save_checkpoint( FILE *fp ) const
+{
+   assert(idle());
+   ckpt_write_tag(fp, "dram");
+   ckpt_write(fp, m_config->nbk);
+   ckpt_write(fp, m_config->nbkgrp);
+   ckpt_write(fp, prio);
+   ckpt_write(fp, rw);
+   ckpt_write(fp, RRDc);
+   ckpt_write(fp, CCDc);
+   ckpt_write(fp, RTWc);
+   ckpt_write(fp, WTRc);
+   for (unsigned j=0;j<m_config->nbk;j++) 
+      ckpt_write(fp, *bk[j]);
+   for (unsigned j=0;j<m_config->nbkgrp;j++) 
+      ckpt_write(fp, *bkgrp[j]);
+}
+
+void dram_t::load_checkpoint( FILE *fp )
+{
+   assert(idle());
+   ckpt_check_tag(fp, "dram");
+   ckpt_check(fp, m_config->nbk, "number of DRAM banks");
+   ckpt_check(fp, m_config->nbkgrp, "number of DRAM bank groups");
+   ckpt_read(fp, prio);
+   ckpt_read(fp, rw);
+   rwq->set_min_length((rw == READ)? m_config->CL : m_config->WL);
+   ckpt_read(fp, RRDc);
+   ckpt_read(fp, CCDc);
+   ckpt_read(fp, RTWc);
+   ckpt_read(fp, WTRc);
+   for (unsigned j=0;j<m_config->nbk;j++) {
+      bank_t saved;
+      ckpt_read(fp, saved);
+      // keep the per-channel stats of this run, only the bank state is restored
+      saved.n_access = bk[j]->n_access;
+      saved.n_writes = bk[j]->n_writes;
+      saved.n_idle = bk[j]->n_idle;
+      saved.mrq = NULL;
+      *bk[j] = saved;
+   }
+   for (unsigned j=0;j<m_config->nbkgrp;j++) 
+      ckpt_read(fp, *bkgrp[j]);
+}
+
 //if mrq is being serviced by dram, gets popped after CL latency fulfilled
 class mem_fetch* dram_t::return_queue_pop() 
 {
@@ -110,6 +110,15 @@ public:
    void cycle();
    void dram_log (int task);
 
+   // An idle channel holds no request in any of its queues or banks, and can be 
+   // advanced by several command cycles at once with fast_forward()
+   bool idle() const;
+   void fast_forward( unsigned n_cycles );
+
+   // open rows and timing constraints of an idle channel in a checkpoint
+   void save_checkpoint( FILE *fp ) const;
+   void load_checkpoint( FILE *fp );
+
    class memory_partition_unit *m_memory_partition_unit;
    unsigned int id;
 
@@ -28,6 +28,7 @@
 #include "gpu-cache.h"
 #include "stat-tool.h"
 #include "gpu-sim.h"
+#include "checkpoint.h"
 #include "../cuda-sim/tm_manager.h"
 
 #include <assert.h>
@@ -74,9 +75,12 @@ unsigned l2_cache_config::set_index(new_addr_type addr) const{
    }
 }
 
+const new_addr_type tag_array::NO_TAG;
+
 tag_array::~tag_array() 
 {
     delete[] m_lines;
+    delete[] m_tags;
 }
 
 tag_array::tag_array( cache_config &config,
@@ -106,6 +110,10 @@ tag_array::tag_array( cache_config &config,
 
 void tag_array::init( int core_id, int type_id )
 {
+    unsigned n_lines = MAX_DEFAULT_CACHE_SIZE_MULTIBLIER*m_config.get_num_lines();
+    m_tags = new new_addr_type[n_lines];
+    for (unsigned i=0; i < n_lines; i++) 
+        m_tags[i] = NO_TAG;
     m_access = 0;
     m_miss = 0;
     m_pending_hit = 0;
@@ -123,31 +131,30 @@ enum cache_request_status tag_array::probe( new_addr_type addr, unsigned &idx )
    //assert( m_config.m_write_policy == READ_ONLY );
    unsigned set_index = m_config.set_index(addr);
    new_addr_type tag = m_config.tag(addr);
+   unsigned set_base = set_index*m_config.m_assoc;
+
+   // check for hit or pending hit: valid tags are unique within a set, so the compare 
+   // runs over the contiguous tags of the set without an early exit 
+   const new_addr_type *tags = &m_tags[set_base];
+   unsigned hit_way = m_config.m_assoc;
+   for (unsigned way=0; way<m_config.m_assoc; way++) 
+      hit_way = (tags[way] == tag)? way : hit_way;
+   if (hit_way != m_config.m_assoc) {
+      idx = set_base + hit_way;
+      assert( m_lines[idx].m_status != INVALID );
+      return (m_lines[idx].m_status == RESERVED)? HIT_RESERVED : HIT;
+   }
 
+   // miss: select the line to replace
    unsigned invalid_line = (unsigned)-1;
    unsigned valid_line = (unsigned)-1;
    unsigned valid_timestamp = (unsigned)-1;
 
    bool all_reserved = true;
    
-   // check for hit or pending hit
    for (unsigned way=0; way<m_config.m_assoc; way++) {
-      unsigned index = set_index*m_config.m_assoc+way;
-      cache_block_t *line = &m_lines[index];
-      if (line->m_tag == tag) {
-         if( line->m_status == RESERVED ) {
-            idx = index;
-            return HIT_RESERVED;
-         } else if( line->m_status == VALID ) {
-            idx = index;
-            return HIT;
-         } else if ( line->m_status == MODIFIED ) {
-            idx = index;
-            return HIT;
-         } else {
-            assert( line->m_status == INVALID );
-         }
-      } 
+      unsigned index = set_base+way;
+      const cache_block_t *line = &m_lines[index];
       if(line->m_status != RESERVED) {
          all_reserved = false;
          if(line->m_status == INVALID) {
@@ -211,6 +218,7 @@ enum cache_request_status tag_array::access( new_addr_type addr, unsigned time,
                 evicted = m_lines[idx];
             }
             m_lines[idx].allocate( m_config.tag(addr), m_config.block_addr(addr), time );
+            m_tags[idx] = m_config.tag(addr);
         }
         break;
     case RESERVATION_FAIL:
@@ -234,6 +242,7 @@ void tag_array::fill( new_addr_type addr, unsigned time, bool wr )
     enum cache_request_status status = probe(addr,idx);
     assert(status==MISS); // MSHR should have prevented redundant memory request
     m_lines[idx].allocate( m_config.tag(addr), m_config.block_addr(addr), time );
+    m_tags[idx] = m_config.tag(addr);
     m_lines[idx].fill(time);
 }
 
@@ -243,10 +252,51 @@ void tag_array::fill( unsigned index, unsigned time, bool wr )
     m_lines[index].fill(time);
 }
 
+// install a line without modelling the miss (e.g. functional fast-forward), access counters are not updated 
+void tag_array::warmup( new_addr_type addr, unsigned time, bool dirty )
+{
+    unsigned idx;
+    enum cache_request_status status = probe(addr,idx);
+    if (status == MISS) {
+        m_lines[idx].allocate( m_config.tag(addr), m_config.block_addr(addr), time );
+        m_lines[idx].fill(time);
+        m_tags[idx] = m_config.tag(addr);
+    } else {
+        assert(status == HIT); // no line is reserved outside of timing simulation
+        m_lines[idx].m_last_access_time = time;
+    }
+    if (dirty) 
+        m_lines[idx].m_status = MODIFIED;
+}
+
 void tag_array::flush() 
 {
-   for (unsigned i=0; i < m_config.get_num_lines(); i++) 
+   for (unsigned i=0; i < m_config.get_num_lines(); i++) {
       m_lines[i].m_status = INVALID;
+      m_tags[i] = NO_TAG;
+   }
+}
+
+void tag_array::save_checkpoint( FILE *fp ) const
+{
+   ckpt_write_tag(fp, "tag_array"); 
+   unsigned n_lines = m_config.get_num_lines(); 
+   ckpt_write(fp, n_lines); 
+   for (unsigned i=0; i < n_lines; i++) {
+      assert(m_lines[i].m_status != RESERVED); 
+      ckpt_write(fp, m_lines[i]); 
+   }
+}
+
+void tag_array::load_checkpoint( FILE *fp )
+{
+   ckpt_check_tag(fp, "tag_array"); 
+   unsigned n_lines = m_config.get_num_lines(); 
+   ckpt_check(fp, n_lines, "cache size"); 
+   for (unsigned i=0; i < n_lines; i++) {
+      ckpt_read(fp, m_lines[i]); 
+      m_tags[i] = (m_lines[i].m_status == INVALID)? NO_TAG : m_lines[i].m_tag; 
+   }
 }
 
 float tag_array::windowed_miss_rate( ) const
@@ -673,6 +723,11 @@ void cache_stats::sample_cache_port_utility(bool data_port_busy, bool fill_port_
     } 
 }
 
+void cache_stats::sample_idle_cache_ports(unsigned long long n_cycles) 
+{
+    m_cache_port_available_cycles += n_cycles; 
+}
+
 void cache_stats::inc_local_write_misses(bool full_cacheline)
 {
     m_local_write_misses++; 
@@ -901,11 +956,10 @@ cache_request_status data_cache::wr_hit_we(new_addr_type addr, unsigned cache_in
 		return RESERVATION_FAIL; // cannot handle request this cycle
 
 	// generate a write-through/evict
-	cache_block_t &block = m_tag_array->get_block(cache_index);
 	send_write_request(mf, WRITE_REQUEST_SENT, time, events);
 
 	// Invalidate block
-	block.m_status = INVALID;
+	m_tag_array->invalidate(cache_index);
 
 	return HIT;
 }
@@ -313,10 +313,16 @@ public:
 
     unsigned size() const { return m_config.get_num_lines(); }
     cache_block_t &get_block(unsigned idx) { return m_lines[idx]; }
+    void invalidate(unsigned idx) { m_lines[idx].invalidate(); m_tags[idx] = NO_TAG; } // keeps the tag mirror in sync 
 
     void flush(); // flash invalidate all entries
     void new_window();
 
+    // tag, state and timestamps of every line (no line may be waiting for a fill)
+    void save_checkpoint( FILE *fp ) const;
+    void load_checkpoint( FILE *fp );
+    void warmup( new_addr_type addr, unsigned time, bool dirty );
+
     void print( FILE *stream, unsigned &total_access, unsigned &total_misses ) const;
     float windowed_miss_rate( ) const;
     void get_stats(unsigned &total_access, unsigned &total_misses, unsigned &total_hit_res, unsigned &total_res_fail) const;
@@ -340,6 +346,10 @@ protected:
     cache_config &m_config;
 
     cache_block_t *m_lines; /* nbanks x nset x assoc lines in total */
+    // tags of m_lines kept contiguous per set for the tag compare in probe(), invalid lines hold 
+    // NO_TAG (only tag_array changes a tag; lines are invalidated through tag_array::invalidate()) 
+    new_addr_type *m_tags;
+    static const new_addr_type NO_TAG = (new_addr_type)-1;
 
     unsigned m_access;
     unsigned m_miss;
@@ -520,6 +530,7 @@ public:
     void get_sub_stats(struct cache_sub_stats &css) const;
 
     void sample_cache_port_utility(bool data_port_busy, bool fill_port_busy); 
+    void sample_idle_cache_ports(unsigned long long n_cycles); 
 
     void inc_local_write_misses(bool full_cacheline); 
 
@@ -610,6 +621,11 @@ public:
     mem_fetch *next_access(){return m_mshrs.next_access();}
     // flash invalidate all entries in cache
     void flush(){m_tag_array->flush();}
+    // warm cache content in a checkpoint
+    void save_checkpoint( FILE *fp ) const {m_tag_array->save_checkpoint(fp);}
+    void load_checkpoint( FILE *fp ) {m_tag_array->load_checkpoint(fp);}
+    // functional access used to warm up the cache content (no statistics, no traffic)
+    void warmup( new_addr_type addr, unsigned time, bool wr ) {m_tag_array->warmup(addr, time, wr && m_config.m_write_policy == WRITE_BACK);}
     void print(FILE *fp, unsigned &accesses, unsigned &misses) const;
     void display_state( FILE *fp, bool detail = false ) const;
 
@@ -628,6 +644,11 @@ public:
     bool data_port_free() const { return m_bandwidth_management.data_port_free(); } 
     bool fill_port_free() const { return m_bandwidth_management.fill_port_free(); } 
 
+    // nothing to send and no access ready, both ports free: cycle() only samples idle ports 
+    bool idle() const { return m_miss_queue.empty() && !access_ready() && data_port_free() && fill_port_free(); }
+    // same as n_cycles calls to cycle() on an idle cache 
+    void skip_idle_cycles( unsigned n_cycles ) { m_stats.sample_idle_cache_ports(n_cycles); }
+
 protected:
     // Constructor that can be used by derived classes with custom tag arrays
     baseline_cache( const char *name,
@@ -1068,6 +1089,9 @@ public:
     bool data_port_free() const { return true; }
     bool fill_port_free() const { return true; }
 
+    // no request to send and no fragment in flight: cycle() does nothing 
+    bool idle() const { return m_request_fifo.empty() && m_fragment_fifo.empty() && m_result_fifo.empty(); }
+
     // Stat collection
     const cache_stats &get_stats() const {
         return m_stats;
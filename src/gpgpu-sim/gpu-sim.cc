@@ -60,6 +60,7 @@
 #include "../cuda-sim/cuda-sim.h"
 #include "../trace.h"
 #include "mem_latency_stat.h"
+#include "checkpoint.h"
 #include "power_stat.h"
 #include "visualizer.h"
 #include "stats.h"
@@ -89,6 +90,9 @@ unsigned long long  gpu_tot_sim_cycle = 0;
 unsigned int gpu_stall_dramfull = 0; 
 unsigned int gpu_stall_icnt2sh = 0;
 
+// core cycles skipped by idle-cycle fast-forward
+unsigned long long gpu_idle_fast_forward_cycles = 0;
+
 /* Clock Domains */
 
 #define  CORE  0x01
@@ -448,6 +452,24 @@ void shader_core_config::reg_options(class OptionParser * opp)
     option_parser_register(opp, "-tlw_use_logical_temporal_cd", OPT_BOOL, &tlw_use_logical_temporal_cd,
                    "use logical temporal conflict detection in pre-commit validation (default = off)",
                    "0");
+    option_parser_register(opp, "-tlw_read_only_fast_commit", OPT_BOOL, &tlw_read_only_fast_commit,
+                   "Commit read-only transactions at the core without commit unit messages, logical timestamp TM only (default = off)",
+                   "0");
+    option_parser_register(opp, "-tlw_early_commit_release", OPT_BOOL, &tlw_early_commit_release,
+                   "Release committing warp once all transaction outcomes are known, commit write-back continues in background, not with -timing_mode_vb_commit (default = off)",
+                   "0");
+    option_parser_register(opp, "-tm_retry_warp_regroup", OPT_BOOL, &tm_retry_warp_regroup,
+                   "Compact the active lanes of warps retrying aborted transactions in the same CTA into shared ALU issue slots (default = off)",
+                   "0");
+    option_parser_register(opp, "-tlw_log_buffer_size", OPT_UINT32, &tlw_log_buffer_size,
+                   "Size of dedicated transaction log buffer per core in bytes (default = 0 = logs are kept in L1D)",
+                   "0");
+    option_parser_register(opp, "-tlw_log_buffer_banks", OPT_UINT32, &tlw_log_buffer_banks,
+                   "Number of banks in the transaction log buffer (default = 4)",
+                   "4");
+    option_parser_register(opp, "-tlw_log_buffer_spill_policy", OPT_UINT32, &tlw_log_buffer_spill_policy,
+                   "Log buffer allocation before spilling to L1D (0 = shared by all warps, 1 = statically partitioned among warps)",
+                   "0");
     option_parser_register(opp, "-tlw_tcd_whitelist_only", OPT_BOOL, &tlw_tcd_whitelist_only,
                    "Temporal conflict detection only whitelist transaction (default = on)",
                    "1");
@@ -501,6 +523,42 @@ void gpgpu_sim_config::reg_options(option_parser_t opp)
    option_parser_register(opp, "-gpgpu_deadlock_detect", OPT_BOOL, &gpu_deadlock_detect, 
                 "Stop the simulation at deadlock (1=on (default), 0=off)", 
                 "1");
+   option_parser_register(opp, "-gpgpu_idle_fast_forward", OPT_UINT32, &gpgpu_idle_fast_forward, 
+                "Skip idle core/interconnect/DRAM cycles once all cores are drained or stalled on memory and the interconnect has been idle for this many cycles (0 = off (default))", 
+                "0");
+   option_parser_register(opp, "-gpgpu_checkpoint_kernel", OPT_UINT32, &gpgpu_checkpoint_kernel, 
+                "Save the simulator state to the checkpoint file at launch of the kernel with this uid; only taken at kernel boundaries, not supported with logical timestamp based TM (0 = off (default))", 
+                "0");
+   option_parser_register(opp, "-gpgpu_resume_kernel", OPT_UINT32, &gpgpu_resume_kernel, 
+                "Restore the checkpoint file at launch of the kernel with this uid, earlier kernels are not simulated and device-to-host copies after them read the checkpointed memory; not supported with logical timestamp based TM (0 = off (default))", 
+                "0");
+   option_parser_register(opp, "-gpgpu_checkpoint_file", OPT_CSTR, &gpgpu_checkpoint_file, 
+                "File the simulator state is saved to/restored from (default = gpgpusim.ckpt)", 
+                "gpgpusim.ckpt");
+   option_parser_register(opp, "-gpgpu_roi_kernel", OPT_UINT32, &gpgpu_roi_kernel, 
+                "Kernels launched before the kernel with this uid are executed functionally (0 = off (default))", 
+                "0");
+   option_parser_register(opp, "-gpgpu_roi_cta", OPT_UINT32, &gpgpu_roi_cta, 
+                "Number of CTAs of the -gpgpu_roi_kernel kernel executed functionally before switching to detailed simulation (default = 0)", 
+                "0");
+   option_parser_register(opp, "-gpgpu_roi_insn", OPT_UINT64, &gpgpu_roi_insn, 
+                "Execute functionally until this many instructions are executed, switching to detailed simulation at the next CTA boundary (0 = off (default))", 
+                "0");
+   option_parser_register(opp, "-gpgpu_roi_warmup_l2", OPT_BOOL, &gpgpu_roi_warmup_l2, 
+                "Global memory accesses executed functionally before the region of interest warm up the L2 cache (default = off)", 
+                "0");
+   option_parser_register(opp, "-gpgpu_sampling_unit", OPT_UINT32, &gpgpu_sampling_unit, 
+                "Sampled simulation: cycles measured in each detailed unit, functional warming in between (0 = off (default))", 
+                "0");
+   option_parser_register(opp, "-gpgpu_sampling_warmup", OPT_UINT32, &gpgpu_sampling_warmup, 
+                "Sampled simulation: detailed warm-up cycles before each measured unit (default = 2000)", 
+                "2000");
+   option_parser_register(opp, "-gpgpu_sampling_ff_ctas", OPT_UINT32, &gpgpu_sampling_ff_ctas, 
+                "Sampled simulation: CTAs executed functionally (warming caches) between detailed units (default = 16)", 
+                "16");
+   option_parser_register(opp, "-gpgpu_sampling_z", OPT_DOUBLE, &gpgpu_sampling_z, 
+                "Sampled simulation: critical value of the reported confidence intervals (default = 1.96, i.e. 95%)", 
+                "1.96");
    option_parser_register(opp, "-gpgpu_ptx_instruction_classification", OPT_INT32, 
                &gpgpu_ptx_instruction_classification, 
                "if enabled will classify ptx instruction types per kernel (Max 255 kernels now)", 
@@ -687,6 +745,21 @@ gpgpu_sim::gpgpu_sim( const gpgpu_sim_config &config )
         }
     }
 
+    m_icnt_idle_cycles = 0;
+    m_roi_started = (m_config.gpgpu_roi_kernel == 0 && m_config.gpgpu_roi_insn == 0);
+    m_roi_ff_insn = 0;
+    m_roi_ff_ctas = 0;
+    m_functional_warming = false;
+    m_sampling_phase = SAMPLING_WARMUP;
+    m_sampling_phase_start = 0;
+    m_sampling_unit_insn = 0;
+    m_sampling_unit_commits = 0;
+    m_sampling_unit_aborts = 0;
+    m_sampling_ff_insn = 0;
+    m_sampling_ff_ctas = 0;
+    m_sampling_drain_cycles = 0;
+    m_resume_memory_restored = false;
+
     m_coherence_manager = new coherence_manager( m_shader_config );
 
     icnt_init(m_shader_config->n_simt_clusters,m_memory_config->m_n_mem_sub_partition);
@@ -798,6 +871,7 @@ void gpgpu_sim::init()
     for (unsigned i=0;i<m_shader_config->n_simt_clusters;i++) 
        m_cluster[i]->reinit();
     m_shader_stats->new_grid();
+    tm_new_kernel(); 
     // initialize the control-flow, memory access, memory latency logger
     if (m_config.g_visualizer_enabled) {
         create_thread_CFlogger( m_config.num_shader(), m_shader_config->n_thread_per_shader, 0, m_config.gpgpu_cflog_interval );
@@ -813,7 +887,7 @@ void gpgpu_sim::init()
     }
 
     if (g_network_mode) 
-       icnt_init_grid(); 
+       icnt_new_grid(); 
 
     // McPAT initialization function. Called on first launch of GPU
 #ifdef GPGPUSIM_POWER_MODEL
@@ -836,9 +910,9 @@ void gpgpu_sim::print_stats()
     gpu_print_stat();
 
     if (g_network_mode) {
-       interconnect_stats();
+       icnt_display_stats();
        printf("----------------------------Interconnect-DETAILS---------------------------------" );
-       icnt_overal_stat();
+       icnt_display_overall_stats();
        printf("----------------------------END-of-Interconnect-DETAILS-------------------------" );
     }
 }
@@ -875,7 +949,7 @@ void gpgpu_sim::deadlock_check()
       }
       if( icnt_busy() ) {
          printf("GPGPU-Sim uArch DEADLOCK:  iterconnect contains traffic\n");
-         display_icnt_state( stdout );
+         icnt_display_state( stdout );
       }
       printf("\nRe-run the simulator in gdb and use debug routines in .gdbinit to debug this\n");
 
@@ -1017,6 +1091,22 @@ void gpgpu_sim::gpu_print_stat()
    // performance counter for stalls due to congestion.
    printf("gpu_stall_dramfull = %d\n", gpu_stall_dramfull);
    printf("gpu_stall_icnt2sh    = %d\n", gpu_stall_icnt2sh );
+   if (m_config.gpgpu_idle_fast_forward) 
+      printf("gpu_idle_fast_forward_cycles = %lld\n", gpu_idle_fast_forward_cycles);
+   if (m_config.gpgpu_roi_kernel || m_config.gpgpu_roi_insn) {
+      printf("gpu_roi_ff_insn = %lld\n", m_roi_ff_insn);
+      printf("gpu_roi_ff_ctas = %lld\n", m_roi_ff_ctas);
+   }
+   if (m_config.gpgpu_sampling_unit) {
+      printf("gpu_sampling_ff_insn = %lld\n", m_sampling_ff_insn);
+      printf("gpu_sampling_ff_ctas = %lld\n", m_sampling_ff_ctas);
+      printf("gpu_sampling_drain_cycles = %lld\n", m_sampling_drain_cycles);
+      m_sampled_ipc.print(stdout, "gpu_sampled_ipc", m_config.gpgpu_sampling_z);
+      m_sampled_commit_rate.print(stdout, "gpu_sampled_tm_commits_per_kcycle", m_config.gpgpu_sampling_z);
+      m_sampled_abort_rate.print(stdout, "gpu_sampled_tm_abort_rate", m_config.gpgpu_sampling_z);
+      if (m_sampled_ipc.mean() > 0) 
+         printf("gpu_sampled_est_tot_cycles = %.0f\n", (gpu_tot_sim_insn + gpu_sim_insn + m_sampling_ff_insn) / m_sampled_ipc.mean());
+   }
 
    time_t curr_time;
    time(&curr_time);
@@ -1284,8 +1374,466 @@ void gpgpu_sim::issue_block2core()
 
 unsigned long long g_single_step=0; // set this in gdb to single step the pipeline
 
+void gpgpu_sim::l2_cycle()
+{
+   m_power_stats->pwr_mem_stat->l2_cache_stats[CURRENT_STAT_IDX].clear();
+   if ((gpu_sim_cycle + gpu_tot_sim_cycle) % g_tm_options.m_logical_temporal_cuckoo_table_num_aborts_dec_period == 0)
+      logical_temporal_conflict_detector::get_singleton().dec_all_num_aborts(); 
+   for (unsigned i=0;i<m_memory_config->m_n_mem_sub_partition;i++) {
+      //move memory request from interconnect into memory partition (if not backed up)
+      //Note:This needs to be called in DRAM clock domain if there is no L2 cache in the system
+      if ( m_memory_sub_partition[i]->full() ) {
+         gpu_stall_dramfull++;
+      } else {
+         mem_fetch* mf = (mem_fetch*) icnt_pop( m_shader_config->mem2device(i) );
+         if (mf) 
+            m_shader_stats->m_outgoing_traffic_stats->record_latency(mf, gpu_sim_cycle + gpu_tot_sim_cycle - mf->get_status_change());
+         m_memory_sub_partition[i]->push( mf, gpu_sim_cycle + gpu_tot_sim_cycle );
+      }
+      m_memory_sub_partition[i]->cache_cycle(gpu_sim_cycle+gpu_tot_sim_cycle);
+      m_memory_sub_partition[i]->accumulate_L2cache_stats(m_power_stats->pwr_mem_stat->l2_cache_stats[CURRENT_STAT_IDX]);
+   }
+}
+
+// size of a memory-to-shader message sent on its own 
+static unsigned icnt_response_size( const mem_fetch *mf )
+{
+   return mf->get_is_write()? mf->get_ctrl_size() : mf->size();
+}
+
+// unicast sizes of the message and of each of its multicast copies 
+static void icnt_multicast_sizes( const mem_fetch *mf, std::vector<unsigned> &sizes )
+{
+   const std::vector<mem_fetch*> &copies = mf->get_multicast_copies();
+   sizes.assign(1, icnt_response_size(mf));
+   for (unsigned c=0;c<copies.size();c++) 
+      sizes.push_back(icnt_response_size(copies[c]));
+}
+
+bool gpgpu_sim::has_buffer_multicast( unsigned input, const mem_fetch *mf, unsigned size ) const
+{
+   std::vector<unsigned> sizes;
+   icnt_multicast_sizes(mf, sizes);
+   return ::icnt_has_buffer_multicast(input, sizes.size(), &sizes[0], size);
+}
+
+// one injection delivers the message and its copies to their own clusters
+void gpgpu_sim::push_multicast( unsigned input, mem_fetch *mf, unsigned size )
+{
+   std::vector<unsigned> outputs(1, mf->get_tpc());
+   std::vector<void*> data(1, (void*)mf);
+   std::vector<unsigned> sizes;
+   icnt_multicast_sizes(mf, sizes);
+   const std::vector<mem_fetch*> &copies = mf->get_multicast_copies();
+   for (unsigned c=0;c<copies.size();c++) {
+      if (!copies[c]->get_is_write()) 
+         copies[c]->set_return_timestamp(gpu_sim_cycle+gpu_tot_sim_cycle);
+      copies[c]->set_status(IN_ICNT_TO_SHADER,gpu_sim_cycle+gpu_tot_sim_cycle);
+      outputs.push_back(copies[c]->get_tpc());
+      data.push_back(copies[c]);
+   }
+   mf->clear_multicast_copies();
+   ::icnt_push_multicast(input, outputs.size(), &outputs[0], &data[0], &sizes[0], size);
+}
+
+bool gpgpu_sim::memory_quiescent( unsigned long long &next_event_cycle ) const
+{
+   for (unsigned i=0;i<m_memory_config->m_n_mem;i++) {
+      if (!m_memory_partition_unit[i]->quiescent(next_event_cycle)) 
+         return false;
+   }
+   return true;
+}
+
+// Idle-cycle fast-forward: once every core has drained or is stalled on memory (see 
+// shader_core_ctx::stalled_on_memory), the interconnect has been idle for gpgpu_idle_fast_forward 
+// cycles and the memory partitions only wait on fixed latencies, the core, interconnect and DRAM 
+// clocks are advanced without being stepped, up to the next event (DRAM latency queue or fixed 
+// latency interconnect delivery) or periodic stat/deadlock/abort-rate check. Stalled cores only 
+// get the stall statistics of the skipped cycles. 
+// The L2 clock is still stepped, since the L2, ROP and commit units can resume on their own, 
+// and fast-forward stops as soon as they queue a request towards the interconnect or DRAM. 
+void gpgpu_sim::fast_forward_idle_cycles()
+{
+   if (m_icnt_idle_cycles < m_config.gpgpu_idle_fast_forward) 
+      return;
+   if (g_interactive_debugger_enabled || g_single_step) 
+      return;
+   // warm-up and measured units end on a cycle count, the functional phase waits for a core to drain 
+   bool sampling_drain = m_config.gpgpu_sampling_unit && m_sampling_phase == SAMPLING_FUNCTIONAL;
+   if (m_config.gpgpu_sampling_unit && !sampling_drain) 
+      return;
+   if (m_shader_config->thread_state_profiling || m_config.gpgpu_flush_l1_cache || m_config.gpgpu_flush_l2_cache) 
+      return;
+   if (tm_fallback_lock_grant_pending()) 
+      return;
+#ifdef GPGPUSIM_POWER_MODEL
+   if (m_config.g_power_simulation_enabled) 
+      return;
+#endif
+   // clusters with work left are skipped only while all their cores wait on memory, and while 
+   // no core can take a new CTA (CTA issue is paused while draining for functional CTAs) 
+   bool more_cta_left = get_more_cta_left();
+   std::vector<bool> stalled(m_shader_config->n_simt_clusters, false);
+   for (unsigned i=0;i<m_shader_config->n_simt_clusters;i++) {
+      if (m_cluster[i]->get_not_completed() || more_cta_left || m_cluster[i]->has_io_pending()) {
+         if (!m_cluster[i]->stalled_on_memory()) 
+            return;
+         if (more_cta_left && !sampling_drain && !m_cluster[i]->cta_issue_blocked()) 
+            return;
+         stalled[i] = true;
+      }
+   }
+   if (icnt_busy()) 
+      return;
+
+   // fixed latency deliveries are timed in gpu_sim_cycle, the memory partitions in total cycles
+   unsigned long long next_event = icnt_next_delivery();
+   if (next_event != (unsigned long long)-1) 
+      next_event += gpu_tot_sim_cycle;
+   if (!memory_quiescent(next_event)) 
+      return;
+
+   // the core clock stops short of the next event and of the next periodic check
+   unsigned long long stop_cycle = (gpu_sim_cycle / m_config.gpu_stat_sample_freq + 1) * m_config.gpu_stat_sample_freq;
+   stop_cycle = std::min(stop_cycle, (gpu_sim_cycle / 200000 + 1) * 200000);
+   if (next_event != (unsigned long long)-1) 
+      stop_cycle = std::min(stop_cycle, next_event - gpu_tot_sim_cycle);
+   if (m_config.gpu_max_cycle_opt) 
+      stop_cycle = std::min(stop_cycle, m_config.gpu_max_cycle_opt - gpu_tot_sim_cycle);
+   if (g_tm_options.m_logical_timestamp_dynamic_concurrency_enabled) {
+      // shader_core_ctx::check_num_aborts() samples the abort rate on a core cycle of a phase boundary 
+      unsigned long long phase = g_tm_options.m_logical_timestamp_exec_phase_length;
+      unsigned long long now = gpu_sim_cycle + gpu_tot_sim_cycle;
+      stop_cycle = std::min(stop_cycle, (now + phase - 1) / phase * phase - gpu_tot_sim_cycle + 1);
+   }
+
+   // stalled cores report the duty cycle of their last cycle once, then zero 
+   float first_duty_cycle = 0;
+   float duty_cycle = 0;
+   for (unsigned i=0;i<m_shader_config->n_simt_clusters;i++) 
+      m_cluster[i]->skipped_duty_cycles(stalled[i], first_duty_cycle, duty_cycle);
+   first_duty_cycle = first_duty_cycle / m_shader_config->num_shader();
+   duty_cycle = duty_cycle / m_shader_config->num_shader();
+
+   unsigned n_core_cycles = 0;
+   unsigned n_icnt_cycles = 0;
+   unsigned n_dram_cycles = 0;
+   while (gpu_sim_cycle + 1 < stop_cycle) {
+      int clock_mask = next_clock_domain();
+      if (clock_mask & DRAM) 
+         n_dram_cycles++;
+      if (clock_mask & L2) 
+         l2_cycle();
+      if (clock_mask & ICNT) 
+         n_icnt_cycles++;
+      if (clock_mask & CORE) {
+         *average_pipeline_duty_cycle = ((*average_pipeline_duty_cycle) + (n_core_cycles? duty_cycle : first_duty_cycle));
+         tm_sample_conflict_footprint(); 
+         gpu_sim_cycle++;
+         n_core_cycles++;
+         try_snap_shot(gpu_sim_cycle);
+         spill_log_to_file (stdout, 0, gpu_sim_cycle);
+      }
+      unsigned long long unused; 
+      if ((clock_mask & L2) && !memory_quiescent(unused)) 
+         break;
+   }
+
+   if (n_dram_cycles) {
+      for (unsigned i=0;i<m_memory_config->m_n_mem;i++) {
+         m_memory_partition_unit[i]->dram_fast_forward(n_dram_cycles);
+         m_memory_partition_unit[i]->set_dram_power_stats(m_power_stats->pwr_mem_stat->n_cmd[CURRENT_STAT_IDX][i], m_power_stats->pwr_mem_stat->n_activity[CURRENT_STAT_IDX][i],
+         m_power_stats->pwr_mem_stat->n_nop[CURRENT_STAT_IDX][i], m_power_stats->pwr_mem_stat->n_act[CURRENT_STAT_IDX][i], m_power_stats->pwr_mem_stat->n_pre[CURRENT_STAT_IDX][i],
+         m_power_stats->pwr_mem_stat->n_rd[CURRENT_STAT_IDX][i], m_power_stats->pwr_mem_stat->n_wr[CURRENT_STAT_IDX][i], m_power_stats->pwr_mem_stat->n_req[CURRENT_STAT_IDX][i]);
+      }
+   }
+   if (n_icnt_cycles) {
+      icnt_skip(n_icnt_cycles);
+      m_icnt_idle_cycles += n_icnt_cycles;
+   }
+   for (unsigned i=0;i<m_shader_config->n_simt_clusters;i++) {
+      if (stalled[i]) {
+         m_cluster[i]->skip_stalled_cycles(n_core_cycles);
+         *active_sms += (float)n_core_cycles * m_cluster[i]->get_n_active_sms();
+      } else {
+         m_shader_stats->gpgpu_n_cycle_shd_inactive += (unsigned long long)n_core_cycles * m_shader_config->n_simt_cores_per_cluster;
+      }
+   }
+   gpu_idle_fast_forward_cycles += n_core_cycles;
+}
+
+bool gpgpu_sim::skip_kernel_before_resume( const kernel_info_t &kernel ) const
+{
+   return m_config.gpgpu_resume_kernel && kernel.get_uid() < m_config.gpgpu_resume_kernel;
+}
+
+// Stream operations queued behind a skipped kernel (e.g. device-to-host copies) must see its results, 
+// so the memory content is restored when the first kernel is skipped. The allocator and texture 
+// bindings are left to the host program until the full restore at launch of the resumed kernel. 
+void gpgpu_sim::restore_memory_for_skipped_kernel()
+{
+   if (m_resume_memory_restored) 
+      return;
+   m_resume_memory_restored = true;
+   FILE *fp = open_checkpoint(m_config.gpgpu_checkpoint_file, m_config.gpgpu_resume_kernel);
+   unsigned long long tot_sim_cycle, tot_sim_insn, tot_issued_cta;
+   ckpt_read(fp, tot_sim_cycle);
+   ckpt_read(fp, tot_sim_insn);
+   ckpt_read(fp, tot_issued_cta);
+   load_functional_checkpoint(fp, true);
+   fclose(fp);
+   printf("GPGPU-Sim uArch: memory content restored from '%s' for the skipped kernels\n", m_config.gpgpu_checkpoint_file);
+}
+
+// Checkpoints are only taken at kernel launch boundaries: all previous kernels have finished, 
+// so no warp, CTA or memory request is in flight and only the functional memory, the cache tags, 
+// the DRAM bank state and the transactional conflict tables persist into the next kernel.
+void gpgpu_sim::checkpoint_at_launch( const kernel_info_t &kernel )
+{
+   unsigned uid = kernel.get_uid();
+   if (uid != m_config.gpgpu_checkpoint_kernel && uid != m_config.gpgpu_resume_kernel) 
+      return;
+   extern tm_options g_tm_options;
+   if (g_tm_options.m_use_logical_timestamp_based_tm) {
+      printf("GPGPU-Sim uArch: ERROR ** checkpoint/restore is not supported with logical timestamp based TM\n");
+      abort();
+   }
+   if (active()) {
+      printf("GPGPU-Sim uArch: ERROR ** checkpoint/restore at launch of kernel %u while the GPU is still busy\n", uid);
+      abort();
+   }
+   if (uid == m_config.gpgpu_resume_kernel) 
+      load_checkpoint(m_config.gpgpu_checkpoint_file, uid);
+   else 
+      save_checkpoint(m_config.gpgpu_checkpoint_file, uid);
+}
+
+static const unsigned gpgpu_checkpoint_magic = 0x4b435047; // "GPCK"
+static const unsigned gpgpu_checkpoint_version = 1;
+
+void gpgpu_sim::save_checkpoint( const char *filename, unsigned kernel_uid ) const
+{
+   FILE *fp = fopen(filename, "wb");
+   if (fp == NULL) {
+      printf("GPGPU-Sim uArch: ERROR ** cannot open checkpoint file '%s' for writing\n", filename);
+      abort();
+   }
+   ckpt_write(fp, gpgpu_checkpoint_magic);
+   ckpt_write(fp, gpgpu_checkpoint_version);
+   ckpt_write(fp, kernel_uid);
+   ckpt_write(fp, m_shader_config->n_simt_clusters);
+   ckpt_write(fp, m_shader_config->n_simt_cores_per_cluster);
+   ckpt_write(fp, m_memory_config->m_n_mem);
+   ckpt_write(fp, m_memory_config->m_n_mem_sub_partition);
+
+   ckpt_write(fp, gpu_tot_sim_cycle);
+   ckpt_write(fp, gpu_tot_sim_insn);
+   ckpt_write(fp, gpu_tot_issued_cta);
+
+   save_functional_checkpoint(fp);
+   for (unsigned i=0;i<m_shader_config->n_simt_clusters;i++) 
+      m_cluster[i]->save_checkpoint(fp);
+   for (unsigned i=0;i<m_memory_config->m_n_mem;i++) 
+      m_memory_partition_unit[i]->save_checkpoint(fp);
+   temporal_conflict_detector::get_singleton().save_checkpoint(fp);
+   fclose(fp);
+
+   printf("GPGPU-Sim uArch: checkpoint at launch of kernel %u saved to '%s' (gpu_tot_sim_cycle = %llu)\n", 
+          kernel_uid, filename, gpu_tot_sim_cycle);
+}
+
+FILE *gpgpu_sim::open_checkpoint( const char *filename, unsigned kernel_uid ) const
+{
+   FILE *fp = fopen(filename, "rb");
+   if (fp == NULL) {
+      printf("GPGPU-Sim uArch: ERROR ** cannot open checkpoint file '%s'\n", filename);
+      abort();
+   }
+   ckpt_check(fp, gpgpu_checkpoint_magic, "file format");
+   ckpt_check(fp, gpgpu_checkpoint_version, "version");
+   ckpt_check(fp, kernel_uid, "kernel uid");
+   ckpt_check(fp, m_shader_config->n_simt_clusters, "number of clusters");
+   ckpt_check(fp, m_shader_config->n_simt_cores_per_cluster, "number of cores per cluster");
+   ckpt_check(fp, m_memory_config->m_n_mem, "number of memory partitions");
+   ckpt_check(fp, m_memory_config->m_n_mem_sub_partition, "number of memory sub partitions");
+   return fp;
+}
+
+void gpgpu_sim::load_checkpoint( const char *filename, unsigned kernel_uid )
+{
+   FILE *fp = open_checkpoint(filename, kernel_uid);
+   ckpt_read(fp, gpu_tot_sim_cycle);
+   ckpt_read(fp, gpu_tot_sim_insn);
+   ckpt_read(fp, gpu_tot_issued_cta);
+
+   load_functional_checkpoint(fp);
+   for (unsigned i=0;i<m_shader_config->n_simt_clusters;i++) 
+      m_cluster[i]->load_checkpoint(fp);
+   for (unsigned i=0;i<m_memory_config->m_n_mem;i++) 
+      m_memory_partition_unit[i]->load_checkpoint(fp);
+   temporal_conflict_detector::get_singleton().load_checkpoint(fp);
+   fclose(fp);
+
+   printf("GPGPU-Sim uArch: checkpoint at launch of kernel %u restored from '%s' (gpu_tot_sim_cycle = %llu)\n", 
+          kernel_uid, filename, gpu_tot_sim_cycle);
+}
+
+// The region of interest starts once every enabled threshold is reached. Fast-forwarding 
+// stops at CTA boundaries: a CTA is always executed entirely in one mode. 
+bool gpgpu_sim::roi_reached( const kernel_info_t &kernel, unsigned kernel_ff_ctas ) const
+{
+   if (kernel.get_uid() < m_config.gpgpu_roi_kernel) 
+      return false;
+   if (kernel.get_uid() == m_config.gpgpu_roi_kernel && kernel_ff_ctas < m_config.gpgpu_roi_cta) 
+      return false;
+   if (m_roi_ff_insn < m_config.gpgpu_roi_insn) 
+      return false;
+   return true;
+}
+
+// Execute CTAs of the kernel functionally until the region of interest is reached. The 
+// remaining CTAs (if any) are left to the timing model when the kernel is launched. 
+bool gpgpu_sim::fast_forward_to_roi( kernel_info_t &kernel )
+{
+   if (m_roi_started) 
+      return false;
+
+   unsigned kernel_ff_ctas = 0;
+   m_functional_warming = m_config.gpgpu_roi_warmup_l2;
+   while (!kernel.no_more_ctas_to_run() && !roi_reached(kernel, kernel_ff_ctas)) {
+      unsigned insn_before = g_ptx_sim_num_insn;
+      functionalCoreSim cta(&kernel, this, m_shader_config->warp_size);
+      cta.execute();
+      m_roi_ff_insn += (unsigned)(g_ptx_sim_num_insn - insn_before);
+      kernel_ff_ctas++;
+   }
+   m_functional_warming = false;
+   m_roi_ff_ctas += kernel_ff_ctas;
+
+   if (kernel.no_more_ctas_to_run()) {
+      printf("GPGPU-Sim uArch: kernel \'%s\' (uid %u) fast-forwarded (%u CTAs, %llu instructions executed functionally so far)\n", 
+             kernel.name().c_str(), kernel.get_uid(), kernel_ff_ctas, m_roi_ff_insn);
+      return true;
+   }
+
+   m_roi_started = true;
+   printf("GPGPU-Sim uArch: region of interest starts in kernel \'%s\' (uid %u) after %u CTAs (%llu instructions executed functionally)\n", 
+          kernel.name().c_str(), kernel.get_uid(), kernel_ff_ctas, m_roi_ff_insn);
+   return false;
+}
+
+void gpgpu_sim::functional_warmup( const warp_inst_t &inst )
+{
+   if (!m_functional_warming) 
+      return;
+   if (!inst.space.is_global() || !(inst.is_load() || inst.is_store()) || !inst.per_scalar_thread_valid()) 
+      return;
+   for (unsigned t=0; t < m_shader_config->warp_size; t++) {
+      if (!inst.active(t)) 
+         continue;
+      new_addr_type addr = inst.get_addr(t);
+      addrdec_t tlx;
+      m_memory_config->m_address_mapping.addrdec_tlx(addr, &tlx);
+      m_memory_sub_partition[tlx.sub_partition]->l2_warmup(addr, inst.is_store());
+   }
+}
+
+double sampled_metric::half_width( double z ) const
+{
+   if (m_n < 2) 
+      return 0;
+   double var = (m_sum_sq - m_sum * m_sum / m_n) / (m_n - 1);
+   if (var < 0) 
+      var = 0; // rounding
+   return z * sqrt(var / m_n);
+}
+
+void sampled_metric::print( FILE *fout, const char *name, double z ) const
+{
+   double m = mean();
+   double hw = half_width(z);
+   fprintf(fout, "%s = %.4f +- %.4f (%.2f%%, %u samples)\n", name, m, hw, (m != 0)? 100.0 * hw / m : 0.0, m_n);
+}
+
+// SMARTS-style sampled simulation, at CTA granularity: a detailed warm-up period is followed by 
+// a measured unit, then CTA issue is paused until no transaction is in flight and one core has 
+// no resident CTA, and the next CTAs are executed functionally on the hardware ids of that core 
+// (warming the L2 and, with -tm_functional_warmup_temporal_cd, the temporal conflict detector) 
+// before detailed simulation resumes. The drain cycles are not measured, and idle fast-forward 
+// may skip them. 
+void gpgpu_sim::sampling_cycle()
+{
+   unsigned long long now = gpu_sim_cycle + gpu_tot_sim_cycle;
+   unsigned long long insn = gpu_sim_insn + gpu_tot_sim_insn;
+   switch (m_sampling_phase) {
+   case SAMPLING_WARMUP:
+      if (now - m_sampling_phase_start >= m_config.gpgpu_sampling_warmup) {
+         m_sampling_phase = SAMPLING_MEASURE;
+         m_sampling_phase_start = now;
+         m_sampling_unit_insn = insn;
+         m_sampling_unit_commits = g_tm_global_statistics.m_n_commits;
+         m_sampling_unit_aborts = g_tm_global_statistics.m_n_aborts;
+      }
+      break;
+   case SAMPLING_MEASURE:
+      if (now - m_sampling_phase_start >= m_config.gpgpu_sampling_unit) {
+         double cycles = now - m_sampling_phase_start;
+         unsigned long long commits = g_tm_global_statistics.m_n_commits - m_sampling_unit_commits;
+         unsigned long long aborts = g_tm_global_statistics.m_n_aborts - m_sampling_unit_aborts;
+         m_sampled_ipc.add((insn - m_sampling_unit_insn) / cycles);
+         m_sampled_commit_rate.add(1000.0 * commits / cycles);
+         if (commits + aborts > 0) 
+            m_sampled_abort_rate.add((double)aborts / (commits + aborts));
+         m_sampling_phase = SAMPLING_FUNCTIONAL;
+         m_sampling_phase_start = now;
+      }
+      break;
+   case SAMPLING_FUNCTIONAL:
+      // functional commits must not race with transactions of the timing model, and functional 
+      // CTAs run with the hardware ids of a core (hw CTA 0, tid 0..), which must not be in use 
+      if (g_tm_global_statistics.m_concurrency == 0) {
+         for (unsigned sid=0; sid < m_shader_config->num_shader(); sid++) {
+            unsigned cluster = m_shader_config->sid_to_cluster(sid);
+            if (m_cluster[cluster]->get_core_n_active_cta(m_shader_config->sid_to_cid(sid)) == 0) {
+               m_sampling_drain_cycles += now - m_sampling_phase_start;
+               m_sampling_ff_ctas += sampling_functional_ctas(m_config.gpgpu_sampling_ff_ctas, sid);
+               m_sampling_phase = SAMPLING_WARMUP;
+               m_sampling_phase_start = now;
+               break;
+            }
+         }
+      }
+      break;
+   }
+}
+
+// only kernels still running on a core are fast-forwarded, so that their completion is detected 
+unsigned gpgpu_sim::sampling_functional_ctas( unsigned max_ctas, unsigned sid )
+{
+   unsigned n_ctas = 0;
+   m_functional_warming = true;
+   for (unsigned n=0; n < m_running_kernels.size() && n_ctas < max_ctas; n++) {
+      kernel_info_t *kernel = m_running_kernels[n];
+      if (kernel == NULL || !kernel->running()) 
+         continue;
+      while (!kernel->no_more_ctas_to_run() && n_ctas < max_ctas) {
+         unsigned insn_before = g_ptx_sim_num_insn;
+         functionalCoreSim cta(kernel, this, m_shader_config->warp_size, sid);
+         cta.execute();
+         m_sampling_ff_insn += (unsigned)(g_ptx_sim_num_insn - insn_before);
+         n_ctas++;
+      }
+   }
+   m_functional_warming = false;
+   return n_ctas;
+}
+
 void gpgpu_sim::cycle()
 {
+   if (m_config.gpgpu_idle_fast_forward) 
+      fast_forward_idle_cycles();
+
    int clock_mask = next_clock_domain();
 
    if (clock_mask & CORE ) {
@@ -1300,15 +1848,25 @@ void gpgpu_sim::cycle()
             mem_fetch* mf = m_memory_sub_partition[i]->top(internal_mem_fetch);
             if (mf) {
                 assert(internal_mem_fetch == false);
-                unsigned response_size = mf->get_is_write()?mf->get_ctrl_size():mf->size();
-                if ( ::icnt_has_buffer( m_shader_config->mem2device(i), response_size ) ) {
+                unsigned response_size = icnt_response_size(mf);
+                bool has_buffer;
+                if (mf->has_multicast_copies()) {
+                   response_size += mf->get_multicast_header_size();
+                   has_buffer = has_buffer_multicast(m_shader_config->mem2device(i), mf, response_size);
+                } else {
+                   has_buffer = ::icnt_has_buffer(m_shader_config->mem2device(i), response_size);
+                }
+                if ( has_buffer ) {
                     mem_fetch *mf_pop = m_memory_sub_partition[i]->pop();
 		    if (mf_pop && (mf_pop->stalled() == false)) {
 			assert(mf == mf_pop);
                         if (!mf->get_is_write()) 
                            mf->set_return_timestamp(gpu_sim_cycle+gpu_tot_sim_cycle);
                         mf->set_status(IN_ICNT_TO_SHADER,gpu_sim_cycle+gpu_tot_sim_cycle);
-                        ::icnt_push( m_shader_config->mem2device(i), mf->get_tpc(), mf, response_size );
+                        if (mf->has_multicast_copies()) 
+                           push_multicast(m_shader_config->mem2device(i), mf, response_size);
+                        else 
+                           ::icnt_push( m_shader_config->mem2device(i), mf->get_tpc(), mf, response_size );
 		    }
                 } else {
                     gpu_stall_icnt2sh++;
@@ -1331,21 +1889,7 @@ void gpgpu_sim::cycle()
 
    // L2 operations follow L2 clock domain
    if (clock_mask & L2) {
-      m_power_stats->pwr_mem_stat->l2_cache_stats[CURRENT_STAT_IDX].clear();
-      if ((gpu_sim_cycle + gpu_tot_sim_cycle) % g_tm_options.m_logical_temporal_cuckoo_table_num_aborts_dec_period == 0)
-	  logical_temporal_conflict_detector::get_singleton().dec_all_num_aborts(); 
-      for (unsigned i=0;i<m_memory_config->m_n_mem_sub_partition;i++) {
-          //move memory request from interconnect into memory partition (if not backed up)
-          //Note:This needs to be called in DRAM clock domain if there is no L2 cache in the system
-          if ( m_memory_sub_partition[i]->full() ) {
-             gpu_stall_dramfull++;
-          } else {
-              mem_fetch* mf = (mem_fetch*) icnt_pop( m_shader_config->mem2device(i) );
-              m_memory_sub_partition[i]->push( mf, gpu_sim_cycle + gpu_tot_sim_cycle );
-          }
-          m_memory_sub_partition[i]->cache_cycle(gpu_sim_cycle+gpu_tot_sim_cycle);
-          m_memory_sub_partition[i]->accumulate_L2cache_stats(m_power_stats->pwr_mem_stat->l2_cache_stats[CURRENT_STAT_IDX]);
-       }
+      l2_cycle();
    }
 
    if (clock_mask & ICNT) {
@@ -1368,11 +1912,14 @@ void gpgpu_sim::cycle()
       #endif
 
       icnt_transfer();
+      if (m_config.gpgpu_idle_fast_forward) 
+         m_icnt_idle_cycles = icnt_busy()? 0 : m_icnt_idle_cycles + 1;
    }
 
    if (clock_mask & CORE) {
       // L1 cache + shader core pipeline stages
       m_power_stats->pwr_mem_stat->core_cache_stats[CURRENT_STAT_IDX].clear();
+      tm_fallback_lock_cycle(); 
       for (unsigned i=0;i<m_shader_config->n_simt_clusters;i++) {
          if (m_cluster[i]->get_not_completed() || get_more_cta_left() || m_cluster[i]->has_io_pending() ) {
                m_cluster[i]->core_cycle();
@@ -1411,7 +1958,10 @@ void gpgpu_sim::cycle()
       }
 #endif
 
-      issue_block2core();
+      if (m_config.gpgpu_sampling_unit) 
+         sampling_cycle();
+      if (!m_config.gpgpu_sampling_unit || m_sampling_phase != SAMPLING_FUNCTIONAL) 
+         issue_block2core();
       
       // Depending on configuration, flush the caches once all of threads are completed.
       int all_threads_complete = 1;
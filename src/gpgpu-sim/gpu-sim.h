@@ -357,9 +357,46 @@ private:
 
     unsigned long long liveness_message_freq; 
 
+    // idle interconnect cycles required before idle cycles are fast-forwarded (0 = off)
+    unsigned gpgpu_idle_fast_forward;
+
+    // save the simulator state to gpgpu_checkpoint_file at launch of this kernel (0 = off)
+    unsigned gpgpu_checkpoint_kernel;
+    // restore gpgpu_checkpoint_file at launch of this kernel, earlier kernels are skipped (0 = off)
+    unsigned gpgpu_resume_kernel;
+    char *gpgpu_checkpoint_file;
+
+    // region of interest: everything before it is executed functionally (all 0 = off) 
+    unsigned gpgpu_roi_kernel; // uid of the first kernel simulated in detail 
+    unsigned gpgpu_roi_cta; // CTAs of the roi kernel executed functionally before switching 
+    unsigned long long gpgpu_roi_insn; // functionally executed (thread) instructions before switching 
+    bool gpgpu_roi_warmup_l2; // global accesses executed functionally warm up the L2 tags 
+
+    // sampled simulation: detailed units of this many cycles alternate with functional warming (0 = off) 
+    unsigned gpgpu_sampling_unit;
+    unsigned gpgpu_sampling_warmup; // detailed cycles before each measured unit 
+    unsigned gpgpu_sampling_ff_ctas; // CTAs executed functionally between units 
+    double gpgpu_sampling_z; // critical value of the reported confidence intervals 
+
     friend class gpgpu_sim;
 };
 
+// Mean and confidence interval of a metric measured over the detailed units of sampled simulation 
+class sampled_metric {
+public:
+   sampled_metric() : m_n(0), m_sum(0), m_sum_sq(0) {}
+   void add( double x ) { m_n++; m_sum += x; m_sum_sq += x*x; }
+   unsigned n() const { return m_n; }
+   double mean() const { return m_n? m_sum / m_n : 0; }
+   // half width of the confidence interval for critical value z 
+   double half_width( double z ) const;
+   void print( FILE *fout, const char *name, double z ) const;
+private:
+   unsigned m_n;
+   double m_sum;
+   double m_sum_sq;
+};
+
 class gpgpu_sim : public gpgpu_t {
 public:
    gpgpu_sim( const gpgpu_sim_config &config );
@@ -378,6 +415,15 @@ public:
    void update_stats();
    void deadlock_check();
 
+   // checkpoint/restore at kernel launch boundaries
+   bool skip_kernel_before_resume( const kernel_info_t &kernel ) const;
+   void restore_memory_for_skipped_kernel();
+   void checkpoint_at_launch( const kernel_info_t &kernel );
+
+   // functional fast-forward to the region of interest 
+   bool fast_forward_to_roi( kernel_info_t &kernel ); // return true if the kernel is done 
+   void functional_warmup( const warp_inst_t &inst );
+
    void get_pdom_stack_top_info( unsigned sid, unsigned tid, unsigned *pc, unsigned *rpc );
 
    int shared_mem_size() const;
@@ -425,6 +471,17 @@ private:
    void reinit_clock_domains(void);
    int  next_clock_domain(void);
    void issue_block2core();
+   void l2_cycle();
+   bool has_buffer_multicast( unsigned input, const class mem_fetch *mf, unsigned size ) const;
+   void push_multicast( unsigned input, class mem_fetch *mf, unsigned size );
+   bool memory_quiescent( unsigned long long &next_event_cycle ) const;
+   void fast_forward_idle_cycles();
+   void save_checkpoint( const char *filename, unsigned kernel_uid ) const;
+   FILE *open_checkpoint( const char *filename, unsigned kernel_uid ) const;
+   void load_checkpoint( const char *filename, unsigned kernel_uid );
+   bool roi_reached( const kernel_info_t &kernel, unsigned kernel_ff_ctas ) const;
+   void sampling_cycle();
+   unsigned sampling_functional_ctas( unsigned max_ctas, unsigned sid );
    void print_dram_stats(FILE *fout) const;
    void shader_print_cache_stats( FILE *fout ) const;
    void shader_print_scheduler_stat( FILE* fout, bool print_dynamic_info ) const;
@@ -454,6 +511,27 @@ private:
    double icnt_time;
    double dram_time;
    double l2_time;
+   // consecutive interconnect cycles without traffic in flight 
+   unsigned long long m_icnt_idle_cycles;
+   // functional fast-forward to the region of interest 
+   bool m_roi_started;
+   unsigned long long m_roi_ff_insn;
+   unsigned long long m_roi_ff_ctas;
+   bool m_functional_warming; // functionally executed accesses warm up the L2 
+   // sampled simulation 
+   enum sampling_phase { SAMPLING_WARMUP, SAMPLING_MEASURE, SAMPLING_FUNCTIONAL };
+   enum sampling_phase m_sampling_phase;
+   unsigned long long m_sampling_phase_start;
+   unsigned long long m_sampling_unit_insn;
+   unsigned long long m_sampling_unit_commits;
+   unsigned long long m_sampling_unit_aborts;
+   unsigned long long m_sampling_ff_insn;
+   unsigned long long m_sampling_ff_ctas;
+   unsigned long long m_sampling_drain_cycles; // waiting for a core to lend its ids to functional CTAs 
+   bool m_resume_memory_restored; // memory content restored at the first skipped kernel
+   sampled_metric m_sampled_ipc;
+   sampled_metric m_sampled_commit_rate;
+   sampled_metric m_sampled_abort_rate;
 
    // debug
    bool gpu_deadlock;
@@ -0,0 +1,336 @@
+// Copyright (c) 2009-2011, Tor M. Aamodt
+// The University of British Columbia
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// Redistributions of source code must retain the above copyright notice, this
+// list of conditions and the following disclaimer.
+// Redistributions in binary form must reproduce the above copyright notice, this
+// list of conditions and the following disclaimer in the documentation and/or
+// other materials provided with the distribution.
+// Neither the name of The University of British Columbia nor the names of its
+// contributors may be used to endorse or promote products derived from this
+// software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+// ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+// WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+// OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+#include "icnt_analytical.h"
+#include <assert.h>
+#include <stdlib.h>
+#include <algorithm>
+#include <queue>
+#include <vector>
+#include "../option_parser.h"
+#include "icnt_wrapper.h"
+
+extern unsigned long long gpu_sim_cycle;
+
+static unsigned g_analytical_latency;      // head latency between any two nodes on top of serialization (core cycles)
+static unsigned g_analytical_port_bw;      // injection/ejection port bandwidth (bytes per core cycle)
+static unsigned g_analytical_flit_size;    // packets occupy a whole number of flits
+static unsigned g_analytical_input_buffer; // flits an injection port can hold before refusing packets
+
+void analytical_icnt_reg_options( class OptionParser * opp )
+{
+   option_parser_register(opp, "-icnt_analytical_latency", OPT_UINT32, &g_analytical_latency,
+                          "latency of the analytical interconnect in core cycles on top of packet serialization (-network_mode 2)", "0");
+   option_parser_register(opp, "-icnt_analytical_port_bw", OPT_UINT32, &g_analytical_port_bw,
+                          "analytical interconnect injection/ejection port bandwidth in bytes per core cycle", "32");
+   option_parser_register(opp, "-icnt_analytical_flit_size", OPT_UINT32, &g_analytical_flit_size,
+                          "analytical interconnect flit size in bytes", "32");
+   option_parser_register(opp, "-icnt_analytical_input_buffer", OPT_UINT32, &g_analytical_input_buffer,
+                          "flits queued at an analytical interconnect injection port before it stalls the source", "16");
+}
+
+struct analytical_packet {
+   unsigned long long m_receive_time;
+   unsigned long long m_seq; // keeps packets with the same receive time in push order
+   void *m_data;
+};
+
+class analytical_packet_order {
+public:
+   bool operator() (const analytical_packet &lhs, const analytical_packet &rhs) const
+   {
+      if (lhs.m_receive_time != rhs.m_receive_time)
+         return lhs.m_receive_time > rhs.m_receive_time;
+      return lhs.m_seq > rhs.m_seq;
+   }
+};
+
+typedef std::priority_queue<analytical_packet, std::vector<analytical_packet>, analytical_packet_order> analytical_out_buf;
+
+static unsigned s_n_nodes = 0;
+static unsigned long long s_seq = 0;
+static unsigned s_in_flight = 0;
+
+// port occupancy in byte slots: a port that is free at core cycle t has slot t*port_bw.
+// [1] tracks high priority packets only, [0] all packets (see reserve_port())
+static std::vector<unsigned long long> s_inject_free[2];
+static std::vector<unsigned long long> s_eject_free[2];
+static std::vector<analytical_out_buf> s_out_buf;
+
+struct analytical_icnt_stat {
+   unsigned long long m_packets;
+   unsigned long long m_bytes;
+   unsigned long long m_latency;
+   unsigned long long m_queueing;
+   unsigned long long m_max_latency;
+   unsigned long long m_stalls;
+   unsigned long long m_multicasts;
+   unsigned long long m_cycles;
+   std::vector<unsigned> m_max_out_buf;
+
+   void reset()
+   {
+      m_packets = m_bytes = m_latency = m_queueing = m_max_latency = m_stalls = m_multicasts = m_cycles = 0;
+      m_max_out_buf.assign(s_n_nodes, 0);
+   }
+   void accumulate( const analytical_icnt_stat &s )
+   {
+      m_packets += s.m_packets;
+      m_bytes += s.m_bytes;
+      m_latency += s.m_latency;
+      m_queueing += s.m_queueing;
+      if (s.m_max_latency > m_max_latency)
+         m_max_latency = s.m_max_latency;
+      m_stalls += s.m_stalls;
+      m_multicasts += s.m_multicasts;
+      m_cycles += s.m_cycles;
+      for (unsigned i=0;i<s_n_nodes;i++) {
+         if (s.m_max_out_buf[i] > m_max_out_buf[i])
+            m_max_out_buf[i] = s.m_max_out_buf[i];
+      }
+   }
+   void print( FILE *fp, const char *prefix ) const
+   {
+      fprintf(fp, "%s_packets = %llu\n", prefix, m_packets);
+      fprintf(fp, "%s_multicasts = %llu\n", prefix, m_multicasts);
+      fprintf(fp, "%s_bytes = %llu\n", prefix, m_bytes);
+      fprintf(fp, "%s_avg_latency = %.4f\n", prefix, m_packets? (double)m_latency / m_packets : 0.0);
+      fprintf(fp, "%s_avg_queueing_delay = %.4f\n", prefix, m_packets? (double)m_queueing / m_packets : 0.0);
+      fprintf(fp, "%s_max_latency = %llu\n", prefix, m_max_latency);
+      fprintf(fp, "%s_input_stalls = %llu\n", prefix, m_stalls);
+      // average injection port utilization
+      double capacity = (double)m_cycles * g_analytical_port_bw * s_n_nodes;
+      fprintf(fp, "%s_avg_port_utilization = %.4f\n", prefix, capacity? m_bytes / capacity : 0.0);
+      fprintf(fp, "%s_max_out_buf =", prefix);
+      for (unsigned i=0;i<s_n_nodes;i++)
+         fprintf(fp, " %u", m_max_out_buf[i]);
+      fprintf(fp, "\n");
+   }
+};
+
+static analytical_icnt_stat s_grid_stat;
+static analytical_icnt_stat s_total_stat;
+
+void analytical_icnt_init( unsigned int n_shader, unsigned int n_mem )
+{
+   if (g_analytical_port_bw == 0 || g_analytical_flit_size == 0) {
+      printf("GPGPU-Sim uArch: ERROR ** -icnt_analytical_port_bw and -icnt_analytical_flit_size must be non-zero\n");
+      abort();
+   }
+   s_n_nodes = n_shader + n_mem;
+   for (unsigned p=0;p<2;p++) {
+      s_inject_free[p].assign(s_n_nodes, 0);
+      s_eject_free[p].assign(s_n_nodes, 0);
+   }
+   s_out_buf.resize(s_n_nodes);
+   s_grid_stat.reset();
+   s_total_stat.reset();
+   printf("GPGPU-Sim uArch: analytical interconnect with %u nodes, %u cycle latency, %u B/cycle ports\n",
+          s_n_nodes, g_analytical_latency, g_analytical_port_bw);
+}
+
+// gpu_sim_cycle restarts at every grid; the network is drained by then
+void analytical_icnt_init_grid()
+{
+   assert(s_in_flight == 0);
+   for (unsigned p=0;p<2;p++) {
+      s_inject_free[p].assign(s_n_nodes, 0);
+      s_eject_free[p].assign(s_n_nodes, 0);
+   }
+   s_total_stat.accumulate(s_grid_stat);
+   s_grid_stat.reset();
+}
+
+static unsigned packet_bytes( unsigned int size )
+{
+   unsigned n_flits = size / g_analytical_flit_size + ((size % g_analytical_flit_size)? 1:0);
+   return n_flits * g_analytical_flit_size;
+}
+
+static unsigned long long slot_to_cycle( unsigned long long slot )
+{
+   return (slot + g_analytical_port_bw - 1) / g_analytical_port_bw;
+}
+
+bool analytical_icnt_has_buffer( unsigned input, unsigned int size )
+{
+   unsigned long long now_slot = gpu_sim_cycle * g_analytical_port_bw;
+   unsigned long long backlog = (s_inject_free[0][input] > now_slot)? s_inject_free[0][input] - now_slot : 0;
+   bool has_buffer = backlog + packet_bytes(size) <= (unsigned long long)g_analytical_input_buffer * g_analytical_flit_size;
+   if (!has_buffer)
+      s_grid_stat.m_stalls++;
+   return has_buffer;
+}
+
+// a multicast packet is injected once, at its own size 
+bool analytical_icnt_has_buffer_multicast( unsigned input, unsigned n_outputs, const unsigned *sizes, unsigned int size )
+{
+   return analytical_icnt_has_buffer(input, size);
+}
+
+// Reserves a port for a packet ready at slot 'ready' and returns the slot it starts at. A high
+// priority packet only waits for earlier high priority packets; it takes its length away from the
+// low priority traffic, which waits for everything reserved before it. Delivery times of packets
+// already in flight are not revised.
+static unsigned long long reserve_port( std::vector<unsigned long long> *port_free, unsigned node, 
+                                        unsigned long long ready, unsigned bytes, bool high_priority )
+{
+   unsigned long long start;
+   if (high_priority) {
+      start = std::max(ready, port_free[1][node]);
+      port_free[1][node] = start + bytes;
+      port_free[0][node] = std::max(port_free[0][node], start) + bytes;
+   } else {
+      start = std::max(ready, port_free[0][node]);
+      port_free[0][node] = start + bytes;
+   }
+   return start;
+}
+
+static void queue_delivery( unsigned output, void *data, unsigned long long receive_time, unsigned bytes )
+{
+   analytical_packet p;
+   p.m_receive_time = receive_time;
+   p.m_seq = s_seq++;
+   p.m_data = data;
+   s_out_buf[output].push(p);
+   s_in_flight++;
+
+   unsigned long long latency = receive_time - gpu_sim_cycle;
+   unsigned long long zero_load = g_analytical_latency + slot_to_cycle(bytes);
+   s_grid_stat.m_packets++;
+   s_grid_stat.m_latency += latency;
+   s_grid_stat.m_queueing += (latency > zero_load)? latency - zero_load : 0;
+   if (latency > s_grid_stat.m_max_latency)
+      s_grid_stat.m_max_latency = latency;
+   if (s_out_buf[output].size() > s_grid_stat.m_max_out_buf[output])
+      s_grid_stat.m_max_out_buf[output] = s_out_buf[output].size();
+}
+
+// serialize through the source port, the head then crosses the network
+static unsigned long long inject( unsigned input, unsigned bytes, bool high_priority )
+{
+   unsigned long long now_slot = gpu_sim_cycle * g_analytical_port_bw;
+   unsigned long long inject_start = reserve_port(s_inject_free, input, now_slot, bytes, high_priority);
+   s_grid_stat.m_bytes += bytes;
+   return slot_to_cycle(inject_start) + g_analytical_latency;
+}
+
+// and serializes through the destination port behind earlier packets
+static unsigned long long eject( unsigned output, unsigned long long head_arrival, unsigned bytes, bool high_priority )
+{
+   unsigned long long eject_start = reserve_port(s_eject_free, output, head_arrival * g_analytical_port_bw, bytes, high_priority);
+   return slot_to_cycle(eject_start + bytes);
+}
+
+void analytical_icnt_push( unsigned input, unsigned output, void* data, unsigned int size )
+{
+   unsigned bytes = packet_bytes(size);
+   bool high_priority = icnt_high_priority(data);
+   unsigned long long head_arrival = inject(input, bytes, high_priority);
+   queue_delivery(output, data, eject(output, head_arrival, bytes, high_priority), bytes);
+}
+
+// A multicast packet is injected once and replicated inside the network, each destination 
+// port is occupied once however many copies it receives
+void analytical_icnt_push_multicast( unsigned input, unsigned n_outputs, const unsigned *outputs, void **data, const unsigned *sizes, unsigned int size )
+{
+   unsigned bytes = packet_bytes(size);
+   bool high_priority = icnt_high_priority(data[0]);
+   unsigned long long head_arrival = inject(input, bytes, high_priority);
+   std::vector<unsigned long long> receive_time(n_outputs);
+   for (unsigned i=0;i<n_outputs;i++) {
+      unsigned j;
+      for (j=0;j<i && outputs[j] != outputs[i];j++)
+         ;
+      receive_time[i] = (j < i)? receive_time[j] : eject(outputs[i], head_arrival, bytes, high_priority);
+      queue_delivery(outputs[i], data[i], receive_time[i], bytes);
+   }
+   s_grid_stat.m_multicasts++;
+}
+
+void* analytical_icnt_pop( unsigned output )
+{
+   if (s_out_buf[output].empty() || s_out_buf[output].top().m_receive_time > gpu_sim_cycle)
+      return NULL;
+   void *data = s_out_buf[output].top().m_data;
+   s_out_buf[output].pop();
+   s_in_flight--;
+   return data;
+}
+
+// delivery times are fixed at push, there is nothing to step
+void analytical_icnt_transfer()
+{
+}
+
+void analytical_icnt_skip( unsigned cycles )
+{
+}
+
+unsigned analytical_icnt_busy()
+{
+   return s_in_flight;
+}
+
+unsigned long long analytical_icnt_next_delivery()
+{
+   unsigned long long next_delivery = (unsigned long long)-1;
+   for (unsigned i=0;i<s_n_nodes;i++) {
+      if (!s_out_buf[i].empty() && s_out_buf[i].top().m_receive_time < next_delivery)
+         next_delivery = s_out_buf[i].top().m_receive_time;
+   }
+   return next_delivery;
+}
+
+unsigned analytical_icnt_get_flit_size()
+{
+   return g_analytical_flit_size;
+}
+
+void analytical_icnt_stats()
+{
+   s_grid_stat.m_cycles = gpu_sim_cycle;
+   s_grid_stat.print(stdout, "icnt_analytical");
+}
+
+void analytical_icnt_overal_stat()
+{
+   s_grid_stat.m_cycles = gpu_sim_cycle;
+   analytical_icnt_stat total = s_total_stat;
+   total.accumulate(s_grid_stat);
+   total.print(stdout, "icnt_analytical_tot");
+}
+
+void analytical_icnt_display_state( FILE *fp )
+{
+   fprintf(fp,"GPGPU-Sim uArch: analytical interconnect has %u packets in flight\n", s_in_flight);
+   for (unsigned i=0;i<s_n_nodes;i++) {
+      if (!s_out_buf[i].empty())
+         fprintf(fp,"   out_buf[%u] has %zu packets, next at cycle %llu\n", i, s_out_buf[i].size(), s_out_buf[i].top().m_receive_time);
+   }
+}
@@ -0,0 +1,62 @@
+// Copyright (c) 2009-2011, Tor M. Aamodt
+// The University of British Columbia
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// Redistributions of source code must retain the above copyright notice, this
+// list of conditions and the following disclaimer.
+// Redistributions in binary form must reproduce the above copyright notice, this
+// list of conditions and the following disclaimer in the documentation and/or
+// other materials provided with the distribution.
+// Neither the name of The University of British Columbia nor the names of its
+// contributors may be used to endorse or promote products derived from this
+// software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+// ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+// WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+// OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+#ifndef ICNT_ANALYTICAL_H
+#define ICNT_ANALYTICAL_H
+
+#include <stdio.h>
+
+// Analytical interconnect (-network_mode 2): no routers or flits are simulated. Each node has
+// an injection and an ejection port of fixed bandwidth. A packet serializes through its source
+// port, crosses the network in a fixed zero-load latency and serializes through its destination
+// port, queueing behind earlier packets at either port. Delivery times are computed at push and
+// expressed in gpu_sim_cycle, like the fixed latency mode of intersim. With -icnt_tm_ctrl_priority
+// TM control messages overtake data queued at either port.
+// The defaults match the GTX480 intersim network (config_fermi_islip.icnt, one 32 B flit per cycle and 
+// port) on synthetic request/reply traffic up to about 20% error in round trip latency. The model has no 
+// head-of-line blocking, so past the load where intersim saturates it overestimates throughput.
+
+void analytical_icnt_reg_options( class OptionParser * opp );
+void analytical_icnt_init( unsigned int n_shader, unsigned int n_mem );
+void analytical_icnt_init_grid();
+
+bool analytical_icnt_has_buffer( unsigned input, unsigned int size );
+void analytical_icnt_push( unsigned input, unsigned output, void* data, unsigned int size );
+bool analytical_icnt_has_buffer_multicast( unsigned input, unsigned n_outputs, const unsigned *sizes, unsigned int size );
+void analytical_icnt_push_multicast( unsigned input, unsigned n_outputs, const unsigned *outputs, void **data, const unsigned *sizes, unsigned int size );
+void* analytical_icnt_pop( unsigned output );
+void analytical_icnt_transfer();
+unsigned analytical_icnt_busy();
+void analytical_icnt_skip( unsigned cycles );
+unsigned long long analytical_icnt_next_delivery();
+unsigned analytical_icnt_get_flit_size();
+
+void analytical_icnt_stats();
+void analytical_icnt_overal_stat();
+void analytical_icnt_display_state( FILE *fp );
+
+#endif
@@ -28,36 +28,89 @@
 #include "icnt_wrapper.h"
 #include <assert.h>
 #include "../intersim/interconnect_interface.h"
+#include "icnt_analytical.h"
+#include "mem_fetch.h"
 
 icnt_has_buffer_p icnt_has_buffer;
 icnt_push_p       icnt_push;
+icnt_has_buffer_multicast_p icnt_has_buffer_multicast;
+icnt_push_multicast_p icnt_push_multicast;
 icnt_pop_p        icnt_pop;
 icnt_transfer_p   icnt_transfer;
 icnt_busy_p       icnt_busy;
+icnt_skip_p       icnt_skip;
+icnt_next_delivery_p icnt_next_delivery;
 icnt_get_flit_size_p icnt_get_flit_size;
+icnt_init_grid_p  icnt_new_grid;
+icnt_display_stats_p icnt_display_stats;
+icnt_display_stats_p icnt_display_overall_stats;
+icnt_display_state_p icnt_display_state;
 
 int   g_network_mode;
 char* g_network_config_filename;
+bool  g_icnt_tm_ctrl_priority;
+bool  g_icnt_multicast;
 
 #include "../option_parser.h"
 
 void icnt_reg_options( class OptionParser * opp )
 {
-   option_parser_register(opp, "-network_mode", OPT_INT32, &g_network_mode, "Interconnection network mode", "1");
+   option_parser_register(opp, "-network_mode", OPT_INT32, &g_network_mode, "Interconnection network mode (1 = intersim, 2 = analytical port-contention model, optimistic past intersim saturation)", "1");
    option_parser_register(opp, "-inter_config_file", OPT_CSTR, &g_network_config_filename, "Interconnection network config file", "mesh");
+   option_parser_register(opp, "-icnt_tm_ctrl_priority", OPT_BOOL, &g_icnt_tm_ctrl_priority, 
+                          "TM control messages (commit/abort outcomes, acks, abort and stall notifications) have priority over data in the interconnect", "0");
+   option_parser_register(opp, "-icnt_multicast", OPT_BOOL, &g_icnt_multicast, 
+                          "send TM broadcasts (invalidates, overflow stop/resume, early abort address sets) as multicast packets (analytical network only)", "0");
+   analytical_icnt_reg_options(opp);
+}
+
+bool icnt_high_priority( void *data )
+{
+   return g_icnt_tm_ctrl_priority && ((mem_fetch*)data)->get_icnt_msg_class() == ICNT_TM_CTRL_MSG;
 }
 
 void icnt_init( unsigned int n_shader, unsigned int n_mem )
 {
    switch (g_network_mode) {
    case INTERSIM:
+      // booksim routes unicast packets only, so a multicast would be copied at the source: the 
+      // traffic would not go down and the copies of a broadcast would have to fit the input buffer at once 
+      if (g_icnt_multicast) {
+         printf("GPGPU-Sim uArch: ERROR ** -icnt_multicast requires the analytical network (-network_mode 2)\n");
+         abort();
+      }
       init_interconnect(g_network_config_filename, n_shader, n_mem );
       icnt_has_buffer = interconnect_has_buffer;
       icnt_push       = interconnect_push;
+      icnt_has_buffer_multicast = NULL;
+      icnt_push_multicast = NULL;
       icnt_pop        = interconnect_pop;
       icnt_transfer   = advance_interconnect;
       icnt_busy       = interconnect_busy;
+      icnt_skip       = skip_interconnect;
+      icnt_next_delivery = interconnect_next_delivery;
       icnt_get_flit_size = interconnect_get_flit_size;
+      icnt_new_grid   = icnt_init_grid;
+      icnt_display_stats = interconnect_stats;
+      icnt_display_overall_stats = icnt_overal_stat;
+      icnt_display_state = display_icnt_state;
+     break;
+   case ANALYTICAL:
+      analytical_icnt_init(n_shader, n_mem);
+      icnt_has_buffer = analytical_icnt_has_buffer;
+      icnt_push       = analytical_icnt_push;
+      icnt_has_buffer_multicast = analytical_icnt_has_buffer_multicast;
+      icnt_push_multicast = analytical_icnt_push_multicast;
+      icnt_pop        = analytical_icnt_pop;
+      icnt_transfer   = analytical_icnt_transfer;
+      icnt_busy       = analytical_icnt_busy;
+      icnt_skip       = analytical_icnt_skip;
+      icnt_next_delivery = analytical_icnt_next_delivery;
+      icnt_get_flit_size = analytical_icnt_get_flit_size;
+      icnt_new_grid   = analytical_icnt_init_grid;
+      icnt_display_stats = analytical_icnt_stats;
+      icnt_display_overall_stats = analytical_icnt_overal_stat;
+      icnt_display_state = analytical_icnt_display_state;
      break;
 
    default:
@@ -33,24 +33,43 @@
 // functional interface to the interconnect
 typedef bool (*icnt_has_buffer_p)(unsigned input, unsigned int size);
 typedef void (*icnt_push_p)(unsigned input, unsigned output, void* data, unsigned int size);
+// multicast: sizes[i] is the unicast size of copy i, size the size of the multicast packet 
+typedef bool (*icnt_has_buffer_multicast_p)(unsigned input, unsigned n_outputs, const unsigned *sizes, unsigned int size);
+typedef void (*icnt_push_multicast_p)(unsigned input, unsigned n_outputs, const unsigned *outputs, void **data, const unsigned *sizes, unsigned int size);
 typedef void* (*icnt_pop_p)(unsigned output);
 typedef void (*icnt_transfer_p)( );
 typedef unsigned (*icnt_busy_p)( );
+typedef void (*icnt_skip_p)( unsigned cycles );
+typedef unsigned long long (*icnt_next_delivery_p)( );
 typedef void (*icnt_drain_p)( );
 typedef unsigned (*icnt_get_flit_size_p)();
+typedef void (*icnt_init_grid_p)( );
+typedef void (*icnt_display_stats_p)( );
+typedef void (*icnt_display_state_p)( FILE *fp );
 
 
 extern icnt_has_buffer_p icnt_has_buffer;
 extern icnt_push_p       icnt_push;
+extern icnt_has_buffer_multicast_p icnt_has_buffer_multicast;
+extern icnt_push_multicast_p icnt_push_multicast;
 extern icnt_pop_p        icnt_pop;
 extern icnt_transfer_p   icnt_transfer;
 extern icnt_busy_p       icnt_busy;
+extern icnt_skip_p       icnt_skip;
+extern icnt_next_delivery_p icnt_next_delivery;
 extern icnt_drain_p      icnt_drain;
 extern icnt_get_flit_size_p icnt_get_flit_size;
+extern icnt_init_grid_p  icnt_new_grid;
+extern icnt_display_stats_p icnt_display_stats;
+extern icnt_display_stats_p icnt_display_overall_stats;
+extern icnt_display_state_p icnt_display_state;
 extern int g_network_mode;
+extern bool g_icnt_tm_ctrl_priority;
+extern bool g_icnt_multicast;
 
 enum network_mode {
    INTERSIM = 1,
+   ANALYTICAL = 2,
    N_NETWORK_MODE
 };
 
@@ -58,4 +77,7 @@ void icnt_init( unsigned int n_shader, unsigned int n_mem );
 void icnt_reg_options( class OptionParser * opp );
 void display_icnt_state( FILE *fp );
 
+// TM control messages bypass data when -icnt_tm_ctrl_priority is set
+bool icnt_high_priority( void *data );
+
 #endif
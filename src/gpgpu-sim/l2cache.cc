@@ -250,6 +250,43 @@ void memory_partition_unit::dram_cycle()
     }
 }
 
+bool memory_partition_unit::quiescent( unsigned long long &next_event_cycle ) const
+{
+    if (!m_dram->idle()) 
+        return false; 
+    for (unsigned p = 0; p < m_config->m_n_sub_partition_per_memory_channel; p++) {
+        if (!m_sub_partition[p]->quiescent()) 
+            return false; 
+    }
+    if (!m_dram_latency_queue.empty() && m_dram_latency_queue.front().ready_cycle < next_event_cycle) 
+        next_event_cycle = m_dram_latency_queue.front().ready_cycle; 
+    return true; 
+}
+
+// same as n_dram_cycles calls to dram_cycle() on a quiescent partition before its next event 
+void memory_partition_unit::dram_fast_forward( unsigned n_dram_cycles )
+{
+    m_dram->fast_forward(n_dram_cycles); 
+    for (unsigned i = 0; i < n_dram_cycles; i++) 
+        m_dram->dram_log(SAMPLELOG); 
+}
+
+void memory_partition_unit::save_checkpoint( FILE *fp ) const
+{
+    assert(!busy()); 
+    m_dram->save_checkpoint(fp); 
+    for (unsigned p = 0; p < m_config->m_n_sub_partition_per_memory_channel; p++) 
+        m_sub_partition[p]->save_checkpoint(fp); 
+}
+
+void memory_partition_unit::load_checkpoint( FILE *fp ) 
+{
+    assert(!busy()); 
+    m_dram->load_checkpoint(fp); 
+    for (unsigned p = 0; p < m_config->m_n_sub_partition_per_memory_channel; p++) 
+        m_sub_partition[p]->load_checkpoint(fp); 
+}
+
 void memory_partition_unit::set_done( mem_fetch *mf )
 {
     unsigned global_spid = mf->get_sub_partition_id(); 
@@ -601,11 +638,39 @@ unsigned memory_sub_partition::flushL2()
     return 0; // L2 is read only in this version
 }
 
+void memory_sub_partition::l2_warmup( new_addr_type addr, bool wr )
+{
+    if (!m_config->m_L2_config.disabled() && !m_config->m_L2_texure_only) 
+        m_L2cache->warmup(addr, gpu_sim_cycle+gpu_tot_sim_cycle, wr);
+}
+
 bool memory_sub_partition::busy() const 
 {
     return !m_request_tracker.empty() || m_commit_unit->get_busy();
 }
 
+// nothing queued between the interconnect, L2 and DRAM (requests may still wait in the ROP 
+// or inside the L2 and commit unit, those are stepped in cache_cycle()) 
+void memory_sub_partition::save_checkpoint( FILE *fp ) const
+{
+    if (!m_config->m_L2_config.disabled()) 
+        m_L2cache->save_checkpoint(fp); 
+}
+
+void memory_sub_partition::load_checkpoint( FILE *fp )
+{
+    if (!m_config->m_L2_config.disabled()) 
+        m_L2cache->load_checkpoint(fp); 
+}
+
+bool memory_sub_partition::quiescent() const 
+{
+    if (g_tm_options.m_use_logical_timestamp_based_tm and not tm_req_stall_queue::get_singleton().empty(m_id)) 
+        return false; // stalled requests are retried in the interconnect clock domain 
+    return (m_icnt_L2_queue->empty() and m_L2_icnt_queue->empty() and 
+            m_L2_dram_queue->empty() and m_dram_L2_queue->empty()); 
+}
+
 void memory_sub_partition::push( mem_fetch* req, unsigned long long cycle ) 
 {
     if (req) {
@@ -155,6 +155,16 @@ public:
    void cache_cycle( unsigned cycle );
    void dram_cycle();
 
+   // Idle-cycle fast-forward: the partition is quiescent when its DRAM channel is idle and 
+   // no sub partition has a request queued towards or from it; the only pending event is 
+   // then the head of the DRAM latency queue, which lowers next_event_cycle
+   bool quiescent( unsigned long long &next_event_cycle ) const;
+   void dram_fast_forward( unsigned n_dram_cycles );
+
+   // DRAM and L2 state of a drained partition in a checkpoint
+   void save_checkpoint( FILE *fp ) const;
+   void load_checkpoint( FILE *fp );
+
    void set_done( mem_fetch *mf );
 
    void visualizer_print( gzFile visualizer_file ) const;
@@ -240,6 +250,7 @@ public:
    unsigned get_id() const { return m_id; } 
 
    bool busy() const;
+   bool quiescent() const;
 
    void cache_cycle( unsigned cycle );
 
@@ -250,6 +261,9 @@ public:
    void set_done( mem_fetch *mf );
 
    unsigned flushL2();
+   void l2_warmup( new_addr_type addr, bool wr );
+   void save_checkpoint( FILE *fp ) const;
+   void load_checkpoint( FILE *fp );
 
    // interface to L2_dram_queue
    bool L2_dram_queue_empty() const; 
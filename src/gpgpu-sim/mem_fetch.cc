@@ -33,6 +33,79 @@
 
 unsigned mem_fetch::sm_next_mf_request_uid=1;
 
+// Deleted mem_fetch objects are kept on a free list and their storage reused for the next 
+// mem_fetch, instead of going through the heap for every memory access and TM message. 
+// The DRAM worker threads delete write-backs, so the list is guarded by a spin lock 
+// (never contended in a serial run). 
+struct mem_fetch_free_block {
+   mem_fetch_free_block *m_next;
+};
+static mem_fetch_free_block *g_mem_fetch_free_list = NULL;
+static volatile int g_mem_fetch_free_list_lock = 0;
+
+void* mem_fetch::operator new( size_t size )
+{
+   assert(size == sizeof(mem_fetch));
+   while (__sync_lock_test_and_set(&g_mem_fetch_free_list_lock, 1)) 
+      ;
+   mem_fetch_free_block *block = g_mem_fetch_free_list;
+   if (block) 
+      g_mem_fetch_free_list = block->m_next;
+   __sync_lock_release(&g_mem_fetch_free_list_lock);
+   if (block) 
+      return block;
+   return ::operator new(size);
+}
+
+void mem_fetch::operator delete( void *p )
+{
+   if (p == NULL) 
+      return;
+   mem_fetch_free_block *block = (mem_fetch_free_block*)p;
+   while (__sync_lock_test_and_set(&g_mem_fetch_free_list_lock, 1)) 
+      ;
+   block->m_next = g_mem_fetch_free_list;
+   g_mem_fetch_free_list = block;
+   __sync_lock_release(&g_mem_fetch_free_list_lock);
+}
+
+coalesced_packet_list::coalesced_packet_list( const coalesced_packet_list &other )
+   : m_packets(m_inline), m_capacity(N_INLINE), m_head(0), m_tail(0)
+{
+   *this = other;
+}
+
+coalesced_packet_list& coalesced_packet_list::operator=( const coalesced_packet_list &other )
+{
+   if (this == &other) 
+      return *this;
+   m_head = m_tail = 0;
+   for (const_iterator i = other.begin(); i != other.end(); ++i) 
+      push_back(*i);
+   return *this;
+}
+
+void coalesced_packet_list::push_back( mem_fetch *mf )
+{
+   if (m_tail == m_capacity) {
+      unsigned n = m_tail - m_head;
+      if (m_head > 0) {
+         // reuse the space of popped packets 
+         memmove(m_packets, m_packets + m_head, n * sizeof(mem_fetch*));
+      } else {
+         mem_fetch **packets = new mem_fetch*[2 * m_capacity];
+         memcpy(packets, m_packets, n * sizeof(mem_fetch*));
+         if (m_packets != m_inline) 
+            delete[] m_packets;
+         m_packets = packets;
+         m_capacity *= 2;
+      }
+      m_head = 0;
+      m_tail = n;
+   }
+   m_packets[m_tail++] = mf;
+}
+
 mem_fetch::mem_fetch( const mem_access_t &access, 
                       const warp_inst_t *inst,
                       unsigned ctrl_size, 
@@ -146,6 +219,54 @@ void mem_fetch::do_atomic()
     m_inst.do_atomic( m_access.get_warp_mask() );
 }
 
+const char *icnt_msg_class_str[N_ICNT_MSG_CLASS] = { "DATA", "TM_DATA", "TM_CTRL" };
+
+enum icnt_msg_class mem_fetch::get_icnt_msg_class() const
+{
+   switch (m_type) {
+   case TX_READ_SET:
+   case TX_WRITE_SET:
+   case TR_LOAD_REQ:
+   case TR_LOAD_REPLY:
+   case TR_MARK:
+      return ICNT_TM_DATA_MSG;
+   case TX_CU_ALLOC:
+   case TX_DONE_FILL:
+   case TX_SKIP:
+   case TX_PASS:
+   case TX_FAIL:
+   case CU_PASS:
+   case CU_FAIL:
+   case CU_ALLOC_PASS:
+   case CU_ALLOC_FAIL:
+   case CU_DONE_COMMIT:
+   case TR_TID_REQUEST:
+   case TR_TID_REPLY:
+   case TR_SKIP:
+   case TR_NSTID_PROBE_REQ:
+   case TR_NSTID_PROBE_REPLY:
+   case TR_COMMIT:
+   case TR_ABORT:
+   case TR_INVALIDATE:
+   case TR_INVALIDATE_ACK:
+   case TR_OVERFLOW_REQUEST_START:
+   case TR_OVERFLOW_STOP:
+   case TR_OVERFLOW_STOP_ACK:
+   case TR_OVERFLOW_REQUEST_START_ACK:
+   case TR_OVERFLOW_DONE:
+   case TR_OVERFLOW_RESUME:
+   case NEWLY_INSERTED_ADDR:
+   case REMOVED_ADDR:
+      return ICNT_TM_CTRL_MSG;
+   default:
+      break;
+   }
+   // eager TM (logical timestamp) replies that abort or release a stalled request
+   if (is_logical_tm_req() && (m_is_aborted || m_is_stalled))
+      return ICNT_TM_CTRL_MSG;
+   return ICNT_DATA_MSG;
+}
+
 bool mem_fetch::is_logical_tm_req() const
 {
    if( m_inst.empty() ) return false;
@@ -209,6 +330,7 @@ unsigned mem_fetch::get_num_flits(bool simt_to_mem){
          sz = size(); 
       }
    }
+   sz += get_multicast_header_size(); // the copies share this packet's flits 
 
    return (sz/icnt_flit_size) + ( (sz % icnt_flit_size)? 1:0);
 }
@@ -243,7 +365,7 @@ bool mem_fetch::partial_processed_packet() const
 }
 
 // retrieve the list of coalesced packet for batch processing 
-std::list<mem_fetch*>& mem_fetch::get_coalesced_packet_list() 
+const coalesced_packet_list& mem_fetch::get_coalesced_packet_list() const
 {
    return m_coalesced_packets; 
 }
@@ -32,6 +32,7 @@
 #include "../abstract_hardware_model.h"
 #include <bitset>
 #include <set>
+#include <vector>
 
 enum mf_type {
     READ_REQUEST = 0,
@@ -81,6 +82,15 @@ enum mf_type {
     REMOVED_ADDR
 };
 
+// interconnect message classes, keyed by mf_type (see mem_fetch::get_icnt_msg_class())
+enum icnt_msg_class {
+    ICNT_DATA_MSG = 0,  // regular memory requests and replies
+    ICNT_TM_DATA_MSG,   // TM messages carrying read/write set entries or data
+    ICNT_TM_CTRL_MSG,   // TM outcomes, acks and abort/stall notifications
+    N_ICNT_MSG_CLASS
+};
+extern const char *icnt_msg_class_str[N_ICNT_MSG_CLASS];
+
 #define MF_TUP_BEGIN(X) enum X {
 #define MF_TUP(X) X
 #define MF_TUP_END(X) };
@@ -90,6 +100,35 @@ enum mf_type {
 #undef MF_TUP_END
 
 class tm_manager_inf; 
+class mem_fetch;
+
+// FIFO of the scalar packets coalesced into a message. Most messages carry a few packets, 
+// these are stored in place; longer lists move to the heap. 
+class coalesced_packet_list {
+public:
+   typedef mem_fetch* const* const_iterator;
+
+   coalesced_packet_list() : m_packets(m_inline), m_capacity(N_INLINE), m_head(0), m_tail(0) {}
+   coalesced_packet_list( const coalesced_packet_list &other );
+   coalesced_packet_list& operator=( const coalesced_packet_list &other );
+   ~coalesced_packet_list() { if (m_packets != m_inline) delete[] m_packets; }
+
+   bool empty() const { return m_head == m_tail; }
+   size_t size() const { return m_tail - m_head; }
+   mem_fetch* front() const { return m_packets[m_head]; }
+   void push_back( mem_fetch *mf );
+   void pop_front() { m_head++; if (m_head == m_tail) m_head = m_tail = 0; }
+   const_iterator begin() const { return m_packets + m_head; }
+   const_iterator end() const { return m_packets + m_tail; }
+
+private:
+   static const unsigned N_INLINE = 8;
+   mem_fetch *m_inline[N_INLINE];
+   mem_fetch **m_packets;
+   unsigned m_capacity;
+   unsigned m_head;
+   unsigned m_tail;
+};
 
 class mem_fetch {
 public:
@@ -119,6 +158,10 @@ public:
     };
    ~mem_fetch();
 
+   // storage of deleted mem_fetch objects is recycled (see mem_fetch.cc) 
+   static void* operator new( size_t size );
+   static void operator delete( void *p );
+
    void set_status( enum mem_fetch_status status, unsigned long long cycle );
    void set_type( enum mf_type t ) { m_type=t; }
    void set_reply() 
@@ -200,6 +243,8 @@ public:
    address_type get_pc() const { return m_inst.empty()?-1:m_inst.pc; }
    const warp_inst_t &get_inst() { return m_inst; }
    enum mem_fetch_status get_status() const { return m_status; }
+   unsigned long long get_status_change() const { return m_status_change; }
+   enum icnt_msg_class get_icnt_msg_class() const;
 
    const memory_config *get_mem_config(){return m_mem_config;}
 
@@ -229,7 +274,14 @@ public:
    mem_fetch* next_coalesced_packet(); 
    void pop_coalesced_packet(); 
    bool partial_processed_packet() const; // detect arrival of new coalesced packet 
-   std::list<mem_fetch*>& get_coalesced_packet_list(); // retrieve the list of coalesced packet for batch processing
+   const coalesced_packet_list& get_coalesced_packet_list() const; // retrieve the list of coalesced packet for batch processing
+
+   // multicast: copies of this message for other destinations travel in the same packet (-icnt_multicast)
+   void add_multicast_copy(mem_fetch *mf) { m_multicast_copies.push_back(mf); }
+   bool has_multicast_copies() const { return !m_multicast_copies.empty(); }
+   const std::vector<mem_fetch*>& get_multicast_copies() const { return m_multicast_copies; }
+   void clear_multicast_copies() { m_multicast_copies.clear(); }
+   unsigned get_multicast_header_size() const { return m_multicast_copies.size(); } // one destination id byte per copy
 
    void set_mem_fetch_pts(unsigned long long pts) { mem_fetch_pts = pts; }
    unsigned long long get_mem_fetch_pts() const { return mem_fetch_pts; } 
@@ -303,13 +355,30 @@ private:
    std::bitset<16>* m_commit_pending_flag; 
 
    // list of coalesced mem_fetch in this mem_fetch 
-   std::list<mem_fetch*> m_coalesced_packets; 
+   coalesced_packet_list m_coalesced_packets; 
    bool m_coalesced_popped; 
 
+   // messages delivered along with this one to other destinations 
+   std::vector<mem_fetch*> m_multicast_copies; 
+
    static unsigned sm_next_mf_request_uid;
 
    const class memory_config *m_mem_config;
    unsigned icnt_flit_size;
 };
 
+// Queues one message of a broadcast. With -icnt_multicast the first message queued becomes the 
+// carrier and the following ones travel with it as multicast copies.
+template<class Queue> void queue_broadcast_packet( Queue &queue, mem_fetch *&carrier, mem_fetch *mf )
+{
+   extern bool g_icnt_multicast;
+   if (g_icnt_multicast && carrier) {
+      carrier->add_multicast_copy(mf);
+      return;
+   }
+   queue.push_back(mf);
+   if (g_icnt_multicast) 
+      carrier = mf;
+}
+
 #endif
@@ -40,6 +40,8 @@ class scoreboard_options
 public:
    unsigned m_tm_token_cnt;  // number of TM tokens per core 
    unsigned m_g_tm_token_cnt;  // number of TM tokens across the GPU 
+   unsigned m_tm_fallback_abort_limit; // aborts of a transaction before it takes the fallback lock 
+   unsigned m_tm_fallback_log_limit; // logged accesses of an aborted transaction beyond which it takes the lock 
 
    void reg_options(option_parser_t opp) {
       option_parser_register(opp, "-scb_tm_token_cnt", OPT_INT32, &m_tm_token_cnt, 
@@ -48,6 +50,12 @@ public:
       option_parser_register(opp, "-scb_g_tm_token_cnt", OPT_INT32, &m_g_tm_token_cnt, 
                   "Number of TM tokens globally (default = 0 = infinite)",
                   "0");
+      option_parser_register(opp, "-scb_tm_fallback_abort_limit", OPT_UINT32, &m_tm_fallback_abort_limit, 
+                  "Aborts of a transaction before its warp retries it irrevocably under a global lock, value-based TM only (default = 0 = never)",
+                  "0");
+      option_parser_register(opp, "-scb_tm_fallback_log_limit", OPT_UINT32, &m_tm_fallback_log_limit, 
+                  "Reads+writes logged by an aborted transaction beyond which its warp retries it under the global lock (default = 0 = no limit)",
+                  "0");
    }
 }; 
 
@@ -115,6 +123,116 @@ void global_scoreboard::print(FILE *fout) const
 
 global_scoreboard g_scoreboard; 
 
+// Global lock of the hybrid TM fallback path. The lock is granted to the oldest requesting warp 
+// once no warp in the GPU is committing. While the lock is held or requested, other warps may 
+// not begin a transaction and warps inside one are paused (unless they are committing), so the 
+// owner runs its transaction alone and commits it without conflicts. 
+// Paused transactions must not own anything the owner needs, so the lock is only supported with 
+// value-based TM (checked in tm_options::check_n_derive). 
+class tm_fallback_lock
+{
+public:
+   tm_fallback_lock() 
+      : m_held(false), m_acquire_time(0), m_n_committing(0), 
+        m_n_acquired(0), m_wait_cycles(0), m_hold_cycles(0) 
+   { }
+
+   void request(unsigned sid, unsigned wid); 
+   void release(unsigned sid, unsigned wid); 
+   // track warps in commit across the GPU 
+   void commit_started() { m_n_committing++; }
+   void commit_done() { assert(m_n_committing > 0); m_n_committing--; }
+   // grant the lock to the oldest waiting warp if possible, called once per core cycle 
+   void cycle(); 
+   bool grant_pending() const { return (not m_held and not m_waiting.empty() and m_n_committing == 0); }
+   // test if the lock keeps a warp from issuing a transactional instruction 
+   bool blocks(unsigned sid, unsigned wid, bool in_tx, bool in_commit, bool is_tbegin) const; 
+
+   void print(FILE *fout) const; 
+private:
+   typedef std::pair<unsigned, unsigned> warp_key; // <sid, wid> 
+   bool m_held; 
+   warp_key m_owner; 
+   unsigned long long m_acquire_time; 
+   std::list<std::pair<warp_key, unsigned long long> > m_waiting; // with request time 
+   unsigned m_n_committing; 
+
+   // stats 
+   unsigned long long m_n_acquired; 
+   unsigned long long m_wait_cycles; // from request to grant 
+   unsigned long long m_hold_cycles; // other transactional work is stalled for these 
+}; 
+
+void tm_fallback_lock::request(unsigned sid, unsigned wid)
+{
+   warp_key w(sid, wid); 
+   if (m_held and m_owner == w) return; 
+   for (std::list<std::pair<warp_key, unsigned long long> >::const_iterator i = m_waiting.begin(); i != m_waiting.end(); ++i) 
+      if (i->first == w) return; 
+   m_waiting.push_back(std::make_pair(w, gpu_sim_cycle + gpu_tot_sim_cycle)); 
+}
+
+void tm_fallback_lock::release(unsigned sid, unsigned wid)
+{
+   warp_key w(sid, wid); 
+   if (m_held and m_owner == w) {
+      m_held = false; 
+      m_hold_cycles += gpu_sim_cycle + gpu_tot_sim_cycle - m_acquire_time; 
+   }
+   for (std::list<std::pair<warp_key, unsigned long long> >::iterator i = m_waiting.begin(); i != m_waiting.end(); ++i) {
+      if (i->first == w) {
+         m_waiting.erase(i); 
+         break; 
+      }
+   }
+}
+
+void tm_fallback_lock::cycle()
+{
+   if (m_held or m_waiting.empty() or m_n_committing > 0) return; 
+   unsigned long long now = gpu_sim_cycle + gpu_tot_sim_cycle; 
+   m_owner = m_waiting.front().first; 
+   m_wait_cycles += now - m_waiting.front().second; 
+   m_waiting.pop_front(); 
+   m_held = true; 
+   m_acquire_time = now; 
+   m_n_acquired++; 
+}
+
+bool tm_fallback_lock::blocks(unsigned sid, unsigned wid, bool in_tx, bool in_commit, bool is_tbegin) const
+{
+   if (not m_held and m_waiting.empty()) return false; 
+   if (m_held and m_owner == warp_key(sid, wid)) return false; 
+   if (in_commit) return false; 
+   return (in_tx or is_tbegin); 
+}
+
+void tm_fallback_lock::print(FILE *fout) const
+{
+   fprintf(fout, "tm_fallback_n_acquired = %llu\n", m_n_acquired); 
+   fprintf(fout, "tm_fallback_wait_cycles = %llu\n", m_wait_cycles); 
+   fprintf(fout, "tm_fallback_hold_cycles = %llu\n", m_hold_cycles); 
+}
+
+tm_fallback_lock g_tm_fallback_lock; 
+
+void tm_fallback_lock_print(FILE *fout)
+{
+   g_tm_fallback_lock.print(fout); 
+}
+
+void tm_fallback_lock_cycle()
+{
+   if (g_scb_options.m_tm_fallback_abort_limit == 0) return; 
+   g_tm_fallback_lock.cycle(); 
+}
+
+bool tm_fallback_lock_grant_pending()
+{
+   if (g_scb_options.m_tm_fallback_abort_limit == 0) return false; 
+   return g_tm_fallback_lock.grant_pending(); 
+}
+
 //Constructor
 Scoreboard::Scoreboard( unsigned sid, unsigned n_warps, simt_stack **simt, bool serialize_tx_warps )
 : longopregs()
@@ -306,7 +424,7 @@ bool Scoreboard::checkCollision( unsigned wid, const class inst_t *inst ) const
    }
 
     // Check for TM token hazard
-    bool tmHazard = checkTMToken(wid, inst); 
+    bool tmHazard = checkTMToken(wid, inst) || checkTMFallbackLock(wid, inst); 
 
     return (dependencyHazard || tmHazard); 
 }
@@ -456,11 +574,15 @@ void Scoreboard::doneTMCommit()
 
 void Scoreboard::startTxCommit(unsigned warp_id)
 {
+   if (m_in_tx_commit[warp_id] == false) 
+      g_tm_fallback_lock.commit_started(); 
    m_in_tx_commit[warp_id] = true; 
 }
 
 void Scoreboard::doneTxCommit(unsigned warp_id)
 {
+   if (m_in_tx_commit[warp_id] == true) 
+      g_tm_fallback_lock.commit_done(); 
    m_in_tx_commit[warp_id] = false; 
 }
 
@@ -492,6 +614,30 @@ bool Scoreboard::someInCommit() const
     return false;
 }
 
+bool Scoreboard::needTMFallback(unsigned abort_count, unsigned n_logged) const
+{
+    if (g_scb_options.m_tm_fallback_abort_limit == 0) return false; 
+    return (abort_count >= g_scb_options.m_tm_fallback_abort_limit or 
+            (g_scb_options.m_tm_fallback_log_limit > 0 and n_logged > g_scb_options.m_tm_fallback_log_limit)); 
+}
+
+void Scoreboard::requestTMFallbackLock(unsigned warp_id)
+{
+    g_tm_fallback_lock.request(m_sid, warp_id); 
+}
+
+void Scoreboard::releaseTMFallbackLock(unsigned warp_id)
+{
+    if (g_scb_options.m_tm_fallback_abort_limit == 0) return; 
+    g_tm_fallback_lock.release(m_sid, warp_id); 
+}
+
+bool Scoreboard::checkTMFallbackLock(unsigned wid, const inst_t *inst) const
+{
+    if (g_scb_options.m_tm_fallback_abort_limit == 0) return false; 
+    return g_tm_fallback_lock.blocks(m_sid, wid, m_simt_stack[wid]->in_transaction(), m_in_tx_commit[wid], inst->is_tbegin); 
+}
+
 void Scoreboard::set_num_tm_tokens(unsigned num_tokens)
 {
     if (num_tokens == 0) {
@@ -522,7 +668,7 @@ bool SimpleScoreboard::checkCollision( unsigned wid, const class inst_t *inst )
     }
 
     // Check for TM token hazard
-    bool tmHazard = checkTMToken(wid, inst); 
+    bool tmHazard = checkTMToken(wid, inst) || checkTMFallbackLock(wid, inst); 
 
     return (dependencyHazard || tmHazard); 
 }
@@ -38,6 +38,9 @@
 #include "../option_parser.h"
 
 void scoreboard_reg_options(option_parser_t opp);
+void tm_fallback_lock_print(FILE *fout);
+void tm_fallback_lock_cycle();
+bool tm_fallback_lock_grant_pending(); // the next tm_fallback_lock_cycle() changes the lock state 
 
 enum data_hazard_t {
    NO_HAZARD = 0,
@@ -91,6 +94,13 @@ public:
 
     void set_num_tm_tokens(unsigned num_tokens);
 
+    // hybrid TM: a warp whose transaction aborted too often (or logged too many accesses) 
+    // finishes it irrevocably under a global lock 
+    bool needTMFallback(unsigned abort_count, unsigned n_logged) const;
+    void requestTMFallbackLock(unsigned warp_id);
+    void releaseTMFallbackLock(unsigned warp_id);
+    bool checkTMFallbackLock(unsigned wid, const inst_t *inst) const;
+
     data_hazard_t getDataHazardType(unsigned wid, const inst_t *inst) const;
 protected:
     void reserveRegister(unsigned wid, unsigned regnum, data_hazard_t hazard_type);
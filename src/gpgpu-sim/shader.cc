@@ -410,6 +410,17 @@ public:
    unsigned n_cu_pass_msg;
    unsigned n_warp_commit_attempt; 
    unsigned n_warp_commit_read_only;
+   unsigned n_read_only_fast_commit; // warps committed through the read-only fast path 
+   unsigned n_read_only_fast_commit_tx; // transactions committed through the read-only fast path 
+   unsigned n_read_only_fast_commit_msg_saved; // commit unit messages not sent due to the fast path 
+   unsigned n_log_buffer_write; // log stores serviced by the log buffer 
+   unsigned n_log_buffer_read; // log reads at commit serviced by the log buffer 
+   unsigned n_log_buffer_spill_write; // log stores sent to L1D because the log buffer is full 
+   unsigned n_log_buffer_spill_read; // log reads at commit sent to L1D because the block was spilled 
+   unsigned n_log_buffer_bank_conflict; 
+   unsigned n_early_commit_release; // warps released before commit write-back finished 
+   unsigned n_early_commit_release_cycle_saved; // cycles between early release and end of commit write-back 
+   unsigned n_early_commit_release_stall; // cycles a commit stalled on the background write-back of the previous one 
    unsigned n_pre_commit_validation_abort; 
    unsigned n_pre_commit_validation_pass; 
    unsigned n_intra_warp_conflicts_detected; 
@@ -429,6 +440,9 @@ public:
    linear_histogram m_coalesced_packet_size;
    pow2_histogram m_warp_read_log_size; 
    pow2_histogram m_warp_write_log_size; 
+   pow2_histogram m_log_buffer_occupancy; 
+   pow2_histogram m_lane_release_latency; 
+   pow2_histogram m_lane_wait_for_slowest; 
    std::map<int,unsigned*> m_sent_icnt_traffic; 
    
    tx_log_walker_stats() 
@@ -444,7 +458,10 @@ public:
         m_out_txreply_queue_size("tlw_out_txreply_queue_size"),
         m_coalesced_packet_size(1, "tlw_coalesced_packet_size"),
         m_warp_read_log_size("tlw_warp_read_log_size"), 
-        m_warp_write_log_size("tlw_warp_write_log_size") 
+        m_warp_write_log_size("tlw_warp_write_log_size"), 
+        m_log_buffer_occupancy("tlw_log_buffer_occupancy"), 
+        m_lane_release_latency("tlw_lane_release_latency"), 
+        m_lane_wait_for_slowest("tlw_lane_wait_for_slowest") 
    {
       n_atag_read = 0; 
       n_data_read = 0; 
@@ -455,6 +472,17 @@ public:
       n_cu_pass_msg = 0;
       n_warp_commit_attempt = 0; 
       n_warp_commit_read_only = 0; 
+      n_read_only_fast_commit = 0; 
+      n_read_only_fast_commit_tx = 0; 
+      n_read_only_fast_commit_msg_saved = 0; 
+      n_log_buffer_write = 0; 
+      n_log_buffer_read = 0; 
+      n_log_buffer_spill_write = 0; 
+      n_log_buffer_spill_read = 0; 
+      n_log_buffer_bank_conflict = 0; 
+      n_early_commit_release = 0; 
+      n_early_commit_release_cycle_saved = 0; 
+      n_early_commit_release_stall = 0; 
       n_pre_commit_validation_abort = 0; 
       n_pre_commit_validation_pass = 0; 
       n_intra_warp_conflicts_detected = 0; 
@@ -566,6 +594,13 @@ void shader_core_stats::print( FILE* fout ) const
     fprintf(fout,"gpgpu_n_mem_texture = %d\n", gpgpu_n_mem_texture);
     fprintf(fout,"gpgpu_n_mem_const = %d\n", gpgpu_n_mem_const);
     fprintf(fout,"gpgpu_n_tx_msg = %d\n", gpgpu_n_tx_msg);
+    fprintf(fout,"gpgpu_n_tx_retry_issue = %llu\n", gpgpu_n_tx_retry_issue);
+    fprintf(fout,"gpgpu_n_tx_retry_lanes = %llu\n", gpgpu_n_tx_retry_lanes);
+    fprintf(fout,"gpgpu_n_tx_retry_regrouped_insn = %llu\n", gpgpu_n_tx_retry_regrouped_insn);
+    fprintf(fout,"gpgpu_n_tx_retry_remapped_lanes = %llu\n", gpgpu_n_tx_retry_remapped_lanes);
+    fprintf(fout,"gpgpu_tx_retry_simd_efficiency = %.4f\n", 
+            (gpgpu_n_tx_retry_issue > 0)? ((float)gpgpu_n_tx_retry_lanes / (gpgpu_n_tx_retry_issue * m_config->warp_size)) : 0.0f);
+    tm_fallback_lock_print(fout); 
     m_TLW_stats->print(fout); 
 
    fprintf(fout, "gpgpu_n_load_insn  = %d\n", gpgpu_n_load_insn);
@@ -1115,7 +1150,7 @@ void shader_core_ctx::issue_warp_dummy_commit( register_set& pipe_reg_set, const
     g_tm_global_statistics.m_n_dummy_commits++;
 }
 
-void shader_core_ctx::issue_warp( register_set& pipe_reg_set, const warp_inst_t* next_inst, const active_mask_t &active_mask, unsigned warp_id )
+warp_inst_t* shader_core_ctx::issue_warp( register_set& pipe_reg_set, const warp_inst_t* next_inst, const active_mask_t &active_mask, unsigned warp_id )
 {
     warp_inst_t** pipe_reg = pipe_reg_set.get_free();
     assert(pipe_reg);
@@ -1133,6 +1168,10 @@ void shader_core_ctx::issue_warp( register_set& pipe_reg_set, const warp_inst_t*
     }
     (*pipe_reg)->issue( active_mask, issued_mask, warp_id, gpu_tot_sim_cycle + gpu_sim_cycle, m_warp[warp_id].get_dynamic_warp_id() ); // dynamic instruction information
     m_stats->shader_cycle_distro[2+(*pipe_reg)->active_count()]++;
+    if (m_simt_stack[warp_id]->in_tx_retry()) {
+        m_stats->gpgpu_n_tx_retry_issue++;
+        m_stats->gpgpu_n_tx_retry_lanes += (*pipe_reg)->active_count();
+    }
 
     func_exec_inst( **pipe_reg );
     if( next_inst->op == BARRIER_OP ) 
@@ -1184,6 +1223,66 @@ void shader_core_ctx::issue_warp( register_set& pipe_reg_set, const warp_inst_t*
           }
        }
     }
+
+    return *pipe_reg;
+}
+
+// Issue an instruction of a retrying warp in the issue slot of another retrying warp (leader) 
+// at the same pc. Its active lanes are compacted onto the lanes of the slot still free (slot_mask 
+// holds the lanes taken so far), so the regrouped instruction occupies the leader's pipeline 
+// register and only its functional and bookkeeping effects are modeled here. 
+void shader_core_ctx::issue_warp_regrouped( const warp_inst_t *leader_inst, const warp_inst_t* next_inst, const active_mask_t &active_mask, unsigned warp_id, active_mask_t &slot_mask )
+{
+    assert(leader_inst->pc == next_inst->pc);
+    assert(slot_mask.count() + active_mask.count() <= m_config->warp_size);
+
+    // lane remap: the n-th active lane of the warp goes to the n-th free lane of the slot 
+    unsigned slot_lane = 0; 
+    for (unsigned t = 0; t < m_config->warp_size; t++) {
+        if (not active_mask.test(t)) continue; 
+        while (slot_mask.test(slot_lane)) slot_lane++; 
+        if (slot_lane != t) m_stats->gpgpu_n_tx_retry_remapped_lanes++; 
+        slot_mask.set(slot_lane); 
+    }
+
+    m_warp[warp_id].ibuffer_free();
+    std::list<warp_inst_t> &regrouped = m_regrouped_retry_insts[leader_inst->get_uid()];
+    regrouped.push_back(*next_inst); // static instruction information
+    warp_inst_t &inst = regrouped.back();
+    inst.issue( active_mask, active_mask, warp_id, gpu_tot_sim_cycle + gpu_sim_cycle, m_warp[warp_id].get_dynamic_warp_id() ); 
+
+    m_stats->gpgpu_n_tx_retry_lanes += inst.active_count();
+    m_stats->gpgpu_n_tx_retry_regrouped_insn++;
+
+    func_exec_inst( inst );
+    updateSIMTStack(warp_id,&inst);
+    m_scoreboard->reserveRegisters(&inst);
+    m_warp[warp_id].set_next_pc(next_inst->pc + next_inst->isize);
+
+    // Profiling - mark threads as in pipeline
+    for ( unsigned t=0; t < m_config->warp_size; t++ ) {
+       if( inst.active(t) ) {
+          unsigned tid = m_config->warp_size * warp_id + t;
+          m_threadState[tid].m_in_pipeline += 1;
+          m_threadState[tid].m_timeout_validation_mode = false;
+       }
+    }
+}
+
+// retire the instructions regrouped into the issue slot of leader_inst 
+void shader_core_ctx::complete_regrouped_insts( const warp_inst_t &leader_inst )
+{
+    std::map<unsigned, std::list<warp_inst_t> >::iterator i_regrouped = m_regrouped_retry_insts.find(leader_inst.get_uid());
+    if (i_regrouped == m_regrouped_retry_insts.end()) return;
+
+    std::list<warp_inst_t> &regrouped = i_regrouped->second;
+    for (std::list<warp_inst_t>::iterator i_inst = regrouped.begin(); i_inst != regrouped.end(); ++i_inst) {
+        // register write-back is accounted for by the leader, which writes the same register row 
+        m_scoreboard->releaseRegisters( &(*i_inst) );
+        dec_inst_in_pipeline(*i_inst);
+        warp_inst_complete(*i_inst);
+    }
+    m_regrouped_retry_insts.erase(i_regrouped);
 }
 
 void shader_core_ctx::issue(){
@@ -1310,6 +1409,7 @@ void scheduler_unit::cycle()
             const warp_inst_t *pI = warp(warp_id).ibuffer_next_inst();
             bool valid = warp(warp_id).ibuffer_next_valid();
             bool warp_inst_issued = false;
+            const warp_inst_t *issued_alu_inst = NULL;
 
             unsigned pc,rpc;
             m_simt_stack[warp_id]->get_pdom_stack_top_info(&pc,&rpc);
@@ -1351,13 +1451,13 @@ void scheduler_unit::cycle()
                             bool sfu_pipe_avail = m_sfu_out->has_free();
                             if( sp_pipe_avail && (pI->op != SFU_OP) ) {
                                 // always prefer SP pipe for operations that can use both SP and SFU pipelines
-                                m_shader->issue_warp(*m_sp_out,pI,active_mask,warp_id);
+                                issued_alu_inst = m_shader->issue_warp(*m_sp_out,pI,active_mask,warp_id);
                                 issued++;
                                 issued_inst=true;
                                 warp_inst_issued = true;
                             } else if ( (pI->op == SFU_OP) || (pI->op == ALU_SFU_OP) ) {
                                 if( sfu_pipe_avail ) {
-                                    m_shader->issue_warp(*m_sfu_out,pI,active_mask,warp_id);
+                                    issued_alu_inst = m_shader->issue_warp(*m_sfu_out,pI,active_mask,warp_id);
                                     issued++;
                                     issued_inst=true;
                                     warp_inst_issued = true;
@@ -1393,6 +1493,7 @@ void scheduler_unit::cycle()
 			                    m_shader->init_aborted_tx_pts(warp_id);
 			                    m_scoreboard->doneTxRestart(warp_id);
                                             (m_shader->get_warps())[warp_id].get_tm_warp_info().reset();
+                                            m_shader->release_tx_log_buffer(warp_id);
 					}
 				    }
 				}
@@ -1415,6 +1516,8 @@ void scheduler_unit::cycle()
                                (*iter)->get_dynamic_warp_id(),
                                issued );
                 do_on_warp_issued( warp_id, issued, iter);
+                if (issued_alu_inst != NULL and m_shader->m_config->tm_retry_warp_regroup) 
+                    regroup_retry_warps( warp_id, pI, issued_alu_inst );
             }
             checked++;
         }
@@ -1445,6 +1548,24 @@ void scheduler_unit::cycle()
         m_stats->shader_cycle_distro[2]++; // pipeline stalled
 }
 
+void scheduler_unit::skip_stalled_cycles( unsigned n_cycles )
+{
+    // every warp with an instruction in its ibuffer fails the scoreboard (see shader_core_ctx::stalled_on_memory) 
+    bool valid_inst = false;
+    order_warps();
+    for ( std::vector< shd_warp_t* >::const_iterator iter = m_next_cycle_prioritized_warps.begin();
+          iter != m_next_cycle_prioritized_warps.end();
+          iter++ ) {
+        if ( (*iter) == NULL || (*iter)->done_exit() || (*iter)->waiting() || (*iter)->ibuffer_empty() ) 
+            continue;
+        valid_inst = true;
+    }
+    if( !valid_inst ) 
+        m_stats->shader_cycle_distro[0] += n_cycles; // idle or control hazard
+    else 
+        m_stats->shader_cycle_distro[1] += n_cycles; // waiting for RAW hazards (possibly due to memory) 
+}
+
 void scheduler_unit::do_on_warp_issued( unsigned warp_id,
                                         unsigned num_issued,
                                         const std::vector< shd_warp_t* >::const_iterator& prioritized_iter )
@@ -1456,6 +1577,44 @@ void scheduler_unit::do_on_warp_issued( unsigned warp_id,
     warp(warp_id).ibuffer_step();
 }
 
+// Fold the same instruction of other warps of this CTA that are retrying an aborted transaction 
+// into the issue slot just used by leader_wid (dynamic warp formation for retries). The active 
+// lanes of a joining warp are remapped onto the free lanes of the slot, so any warps whose lanes 
+// add up to at most a warp can share it. 
+void scheduler_unit::regroup_retry_warps( unsigned leader_wid, const warp_inst_t *pI, const warp_inst_t *leader_inst )
+{
+    if (not m_simt_stack[leader_wid]->in_tx_retry()) return; 
+    if ((pI->op != ALU_OP and pI->op != SFU_OP and pI->op != ALU_SFU_OP) or pI->is_tbegin or pI->is_trollback) 
+        return; // control flow and transaction boundaries stay per warp 
+
+    active_mask_t slot_mask = leader_inst->get_active_mask(); 
+    for ( std::vector< shd_warp_t* >::const_iterator iter = m_supervised_warps.begin();
+          iter != m_supervised_warps.end() and slot_mask.count() < m_shader->get_config()->warp_size;
+          iter++ ) {
+        if ( (*iter) == NULL || (*iter)->done_exit() ) 
+            continue;
+        unsigned wid = (*iter)->get_warp_id(); 
+        if (wid == leader_wid or warp(wid).get_cta_id() != warp(leader_wid).get_cta_id()) 
+            continue; 
+        if (not m_simt_stack[wid]->in_tx_retry() or warp(wid).waiting() or warp(wid).ibuffer_empty()) 
+            continue; 
+
+        const warp_inst_t *fI = warp(wid).ibuffer_next_inst(); 
+        if (fI == NULL or fI->pc != pI->pc) 
+            continue; 
+        unsigned pc,rpc;
+        m_simt_stack[wid]->get_pdom_stack_top_info(&pc,&rpc);
+        if (pc != fI->pc) 
+            continue; // control hazard, let the warp's own issue flush it 
+        const active_mask_t &active_mask = m_simt_stack[wid]->get_active_mask();
+        if (slot_mask.count() + active_mask.count() > m_shader->get_config()->warp_size or m_scoreboard->checkCollision(wid, fI)) 
+            continue; 
+
+        m_shader->issue_warp_regrouped(leader_inst, fI, active_mask, wid, slot_mask); 
+        warp(wid).ibuffer_step(); 
+    }
+}
+
 bool scheduler_unit::sort_warps_by_oldest_dynamic_id(shd_warp_t* lhs, shd_warp_t* rhs)
 {
     if (rhs && lhs) {
@@ -1817,6 +1976,7 @@ void shader_core_ctx::writeback()
         m_scoreboard->releaseRegisters( pipe_reg );
         dec_inst_in_pipeline(*pipe_reg);
         warp_inst_complete(*pipe_reg);
+        complete_regrouped_insts(*pipe_reg);
         m_gpu->gpu_sim_insn_last_update_sid = m_sid;
         m_gpu->gpu_sim_insn_last_update = gpu_sim_cycle;
         m_last_inst_gpu_sim_cycle = gpu_sim_cycle;
@@ -1962,7 +2122,10 @@ bool ldst_unit::memory_cycle( warp_inst_t &inst, mem_stage_stall_type &stall_rea
            bypassL1D = true; 
    }
 
-   if( bypassL1D ) {
+   if ( access.is_tx_log() and m_TLW->get_log_buffer() != NULL and 
+        process_log_buffer_access(inst, stall_cond) ) {
+       // log store serviced by (or stalled at) the dedicated log buffer 
+   } else if( bypassL1D ) {
        // bypass L1 cache
        if( m_icnt->full(size, inst.is_store() || inst.isatomic()) ) {
            stall_cond = ICNT_RC_FAIL;
@@ -1999,6 +2162,49 @@ bool ldst_unit::memory_cycle( warp_inst_t &inst, mem_stage_stall_type &stall_rea
    return inst.accessq_empty(); 
 }
 
+// access a transaction log block in the dedicated log buffer (log append, or write log walk for RAW access) 
+// return: true = handled by log buffer (stall_cond set on bank conflict), false = spill, access L1D instead 
+bool ldst_unit::process_log_buffer_access( warp_inst_t &inst, mem_stage_stall_type &stall_cond )
+{
+   tx_log_buffer *log_buffer = m_TLW->get_log_buffer(); 
+   const mem_access_t &access = inst.accessq_back(); 
+   bool write_access = access.is_write(); 
+   enum tx_log_buffer::status_t status; 
+   if (write_access) 
+      status = log_buffer->write(inst.warp_id(), access.get_addr(), gpu_sim_cycle+gpu_tot_sim_cycle); 
+   else 
+      status = log_buffer->read(inst.warp_id(), access.get_addr(), gpu_sim_cycle+gpu_tot_sim_cycle); 
+   if (status == tx_log_buffer::LB_SPILL) {
+      if (write_access) 
+         m_stats->m_TLW_stats->n_log_buffer_spill_write++; 
+      else 
+         m_stats->m_TLW_stats->n_log_buffer_spill_read++; 
+      return false; 
+   }
+   if (status == tx_log_buffer::LB_HIT) {
+      if (write_access) {
+         m_stats->m_TLW_stats->n_log_buffer_write++; 
+         m_stats->m_TLW_stats->m_log_buffer_occupancy.add2bin(log_buffer->occupancy()); 
+      } else {
+         m_stats->m_TLW_stats->n_log_buffer_read++; 
+         for ( unsigned r=0; r < 4; r++)
+            if (inst.out[r] > 0)
+               m_pending_writes[inst.warp_id()][inst.out[r]]--; 
+      }
+      inst.accessq_pop_back(); 
+   } else {
+      m_stats->m_TLW_stats->n_log_buffer_bank_conflict++; 
+      stall_cond = BK_CONF; 
+   }
+   return true; 
+}
+
+void ldst_unit::release_tx_log_buffer(unsigned warp_id)
+{
+   if (m_TLW->get_log_buffer() != NULL) 
+      m_TLW->get_log_buffer()->release(warp_id); 
+}
+
 bool ldst_unit::response_buffer_full() const
 {
     return m_response_fifo.size() >= m_config->ldst_unit_response_queue_size;
@@ -2015,6 +2221,18 @@ void ldst_unit::flush(){
 	m_L1D->flush();
 }
 
+void ldst_unit::save_checkpoint( FILE *fp ) const
+{
+    if (m_L1D) 
+        m_L1D->save_checkpoint(fp);
+}
+
+void ldst_unit::load_checkpoint( FILE *fp )
+{
+    if (m_L1D) 
+        m_L1D->load_checkpoint(fp);
+}
+
 simd_function_unit::simd_function_unit( const shader_core_config *config )
 { 
     m_config=config;
@@ -2404,6 +2622,24 @@ bool ldst_unit::has_message_pending() const
    return has_message; 
 }
 
+bool ldst_unit::idle() const
+{
+   if( !pipelined_simd_unit::idle() || !m_response_fifo.empty() || !m_next_wb.empty() || m_next_global ) 
+      return false;
+   if( !m_L1T->idle() || !m_L1C->idle() || (m_L1D && !m_L1D->idle()) ) 
+      return false;
+   return m_TLW->idle() && m_operand_collector->idle();
+}
+
+void ldst_unit::skip_idle_cycles( unsigned n_cycles )
+{
+   unsigned n_steps = n_cycles * clock_multiplier();
+   m_operand_collector->skip_idle_steps(n_steps);
+   m_TLW->skip_idle_cycles(n_steps);
+   m_L1C->skip_idle_cycles(n_steps);
+   if( m_L1D ) m_L1D->skip_idle_cycles(n_steps);
+}
+
 void ldst_unit::cycle()
 {
    writeback();
@@ -3025,6 +3261,73 @@ void shader_core_ctx::cycle()
     fetch();
 }
 
+// Idle-cycle fast-forward: the pipeline is drained and every warp has exited or is blocked until a 
+// memory response (or a TM outcome) arrives, so cycle() only counts stall cycles and rotates arbiters. 
+bool shader_core_ctx::stalled_on_memory()
+{
+    if( m_inst_fetch_buffer.m_valid || !m_L1I->idle() || !m_operand_collector.idle() ) 
+        return false;
+    for( unsigned i=0; i < m_pipeline_reg.size(); i++ ) {
+        if( m_pipeline_reg[i].has_ready() ) 
+            return false;
+    }
+    for( unsigned i=0; i < num_result_bus; i++ ) {
+        if( m_result_bus[i]->any() ) 
+            return false;
+    }
+    for( unsigned n=0; n < m_num_function_units; n++ ) {
+        if( !m_fu[n]->idle() ) 
+            return false;
+    }
+    for( unsigned i=0; i < schedulers.size(); i++ ) {
+        if( !schedulers[i]->stateless_order() ) 
+            return false;
+    }
+    for( unsigned w=0; w < m_config->max_warps_per_shader; w++ ) {
+        if( m_warp[w].done_exit() ) 
+            continue;
+        if( m_warp[w].hardware_done() && !m_scoreboard->pendingWrites(w) ) 
+            return false; // exits in fetch()
+        if( !m_warp[w].functional_done() && !m_warp[w].imiss_pending() && m_warp[w].ibuffer_empty() ) 
+            return false; // fetches
+        if( m_warp[w].waiting() || m_warp[w].ibuffer_empty() ) 
+            continue;
+        const warp_inst_t *pI = m_warp[w].ibuffer_next_inst();
+        if( pI == NULL ) 
+            return false;
+        unsigned pc,rpc;
+        m_simt_stack[w]->get_pdom_stack_top_info(&pc,&rpc);
+        if( pc != pI->pc || !m_scoreboard->checkCollision(w, pI) || m_scoreboard->inTxRestart(w) ) 
+            return false; // flushes, issues or restarts its transaction
+    }
+    return true;
+}
+
+// m_pipeline_duty_cycle set by the next writeback() when no instruction completes 
+float shader_core_ctx::stalled_duty_cycle() const
+{
+    unsigned max_committed_thread_instructions=m_config->warp_size * (m_config->pipe_widths[EX_WB]);
+    return ((float)(m_stats->m_num_sim_insn[m_sid]-m_stats->m_last_num_sim_insn[m_sid]))/max_committed_thread_instructions;
+}
+
+// same as n_cycles calls to cycle() on a core stalled on memory, within one abort-rate phase 
+void shader_core_ctx::skip_stalled_cycles( unsigned n_cycles )
+{
+    if( n_cycles == 0 ) 
+        return;
+    m_stats->shader_cycles[m_sid] += n_cycles;
+    unsigned n_masked_tm_token = num_masked_tm_token();
+    for( unsigned c=0; c < n_cycles; c++ ) 
+        g_tm_global_statistics.m_num_masked_tm_token.add2bin(n_masked_tm_token);
+    m_stats->m_pipeline_duty_cycle[m_sid] = (n_cycles > 1)? 0 : stalled_duty_cycle();
+    m_stats->m_last_num_sim_insn[m_sid]=m_stats->m_num_sim_insn[m_sid];
+    m_stats->m_last_num_sim_winsn[m_sid]=m_stats->m_num_sim_winsn[m_sid];
+    m_ldst_unit->skip_idle_cycles(n_cycles);
+    m_L1I->skip_idle_cycles(n_cycles);
+    for( unsigned i=0; i < schedulers.size(); i++ ) 
+        schedulers[i]->skip_stalled_cycles(n_cycles);
+}
+
 void shader_core_ctx::profile_thread_states()
 {
    for(unsigned tid=0; tid < m_config->n_thread_per_shader; tid++) {
@@ -3156,6 +3459,17 @@ void shader_core_ctx::cache_flush()
    m_ldst_unit->flush();
 }
 
+// only the L1 data cache content outlives a kernel, the pipeline is drained at kernel boundaries
+void shader_core_ctx::save_checkpoint( FILE *fp ) const
+{
+   m_ldst_unit->save_checkpoint(fp);
+}
+
+void shader_core_ctx::load_checkpoint( FILE *fp )
+{
+   m_ldst_unit->load_checkpoint(fp);
+}
+
 // modifiers
 std::list<opndcoll_rfu_t::op_t> opndcoll_rfu_t::arbiter_t::allocate_reads() 
 {
@@ -3608,11 +3922,12 @@ void shader_core_ctx::initiate_timing_model_transaction_commit( unsigned warp_id
     #endif 
 }
 
-void shader_core_ctx::commit_warp_cleanup(unsigned warp_id)
+void shader_core_ctx::commit_warp_cleanup(unsigned warp_id, bool keep_tm_ownership)
 {
    if (m_simt_stack[warp_id]->in_transaction() == false) {
        m_operand_collector.history_file_commit_clear(); 
-       m_scoreboard->releaseTMToken(warp_id); 
+       if (not keep_tm_ownership) 
+          release_tm_ownership(warp_id); 
 
        // Thread profiler code - clear threads from commit
        for ( unsigned t=0; t < m_config->warp_size; t++ ) {
@@ -3624,9 +3939,24 @@ void shader_core_ctx::commit_warp_cleanup(unsigned warp_id)
        unsigned hwwarpid = m_sid*m_config->max_warps_per_shader + warp_id; // global hw warp id across all shader cores
        m_gpu->get_coherence_manager()->tm_warp_commited(hwwarpid);
    }
+   if (has_paused_threads(warp_id) == false) 
+       release_tx_log_buffer(warp_id); 
    init_aborted_tx_pts(warp_id);
 }
 
+void shader_core_ctx::release_tm_ownership(unsigned warp_id)
+{
+   // a warp released early may have begun its next transaction, which keeps them until its own commit 
+   if (m_simt_stack[warp_id]->in_transaction()) return; 
+   m_scoreboard->releaseTMToken(warp_id); 
+   m_scoreboard->releaseTMFallbackLock(warp_id); 
+}
+
+void shader_core_ctx::release_tx_log_buffer(unsigned warp_id)
+{
+   m_ldst_unit->release_tx_log_buffer(warp_id); 
+}
+
 void shader_core_ctx::commit_callback( unsigned thread_id, unsigned warp_id, address_type commit_pc )
 {
     // COH model commit callback
@@ -3694,10 +4024,25 @@ void shader_core_ctx::rollback_callback( unsigned thread_id, unsigned warp_id, a
 	rolled_back = true;
     }
     
+    // same for instructions regrouped into another warp's issue slot 
+    for (std::map<unsigned, std::list<warp_inst_t> >::iterator i_regrouped = m_regrouped_retry_insts.begin(); 
+         i_regrouped != m_regrouped_retry_insts.end(); ++i_regrouped) {
+        std::list<warp_inst_t> &regrouped = i_regrouped->second;
+        for (std::list<warp_inst_t>::iterator i_inst = regrouped.begin(); i_inst != regrouped.end(); ++i_inst) {
+            if (i_inst->warp_id() == warp_id and (not logical_tm or i_inst->active(thread_id % m_config->warp_size))) {
+                i_inst->set_not_active(thread_id % m_config->warp_size);
+                if (logical_tm) m_threadState[thread_id].m_in_pipeline -= 1;
+                rolled_back = true;
+            }
+        }
+    }
+    
     m_warp[warp_id].ibuffer_flush();  // WF: not sure if this is needed 
 
     // If don't need to clear number of writing, just reset log. Otherwise, delay it until number of writing is cleared.
     tm_manager_inf *t_tm_manager = get_func_thread_info(thread_id)->get_tm_manager();
+    if (m_scoreboard->needTMFallback(t_tm_manager->abort_count(), t_tm_manager->get_n_read() + t_tm_manager->get_n_write())) 
+        m_scoreboard->requestTMFallbackLock(warp_id); // retry it irrevocably 
     if (t_tm_manager->get_is_abort_need_clean() == false) {
 	unsigned lane_id = thread_id % m_config->warp_size;
         m_warp[warp_id].get_tm_warp_info().reset_lane(lane_id);
@@ -4185,6 +4530,17 @@ bool opndcoll_rfu_t::in_rollback() const
    return m_history_file.in_rollback(); 
 }
 
+bool opndcoll_rfu_t::idle() const
+{
+   if( in_rollback() || !m_arbiter.idle() ) 
+      return false;
+   for( unsigned c=0; c < m_cu.size(); c++ ) {
+      if( !m_cu[c]->is_free() ) 
+         return false;
+   }
+   return true;
+}
+
 void opndcoll_rfu_t::history_file_start_rollback()
 {
    if ( !history_file_enabled() ) return; 
@@ -4482,6 +4838,54 @@ unsigned simt_core_cluster::get_n_active_sms() const
     return n;
 }
 
+bool simt_core_cluster::stalled_on_memory()
+{
+    if( !m_response_fifo.empty() ) 
+        return false;
+    for( unsigned i=0; i < m_config->n_simt_cores_per_cluster; i++ ) {
+        if( !m_core[i]->stalled_on_memory() ) 
+            return false;
+    }
+    return true;
+}
+
+void simt_core_cluster::skip_stalled_cycles( unsigned n_cycles )
+{
+    for( unsigned i=0; i < m_config->n_simt_cores_per_cluster; i++ ) 
+        m_core[i]->skip_stalled_cycles(n_cycles);
+    if (m_config->simt_core_sim_order == 1) {
+        for( unsigned c=0; c < n_cycles % m_config->n_simt_cores_per_cluster; c++ ) 
+            m_core_sim_order.splice(m_core_sim_order.end(), m_core_sim_order, m_core_sim_order.begin()); 
+    }
+}
+
+// m_pipeline_duty_cycle of the cores summed over the first and over the following skipped cycles 
+void simt_core_cluster::skipped_duty_cycles( bool stalled, float &first, float &steady ) const
+{
+    for( unsigned i=0; i < m_config->n_simt_cores_per_cluster; i++ ) {
+        if( stalled ) {
+            first += m_core[i]->stalled_duty_cycle();
+        } else {
+            unsigned sid = m_config->cid_to_sid(i,m_cluster_id);
+            first += m_stats->m_pipeline_duty_cycle[sid];
+            steady += m_stats->m_pipeline_duty_cycle[sid];
+        }
+    }
+}
+
+// issue_block2core() cannot place a CTA on any core of this cluster until one of them finishes one 
+bool simt_core_cluster::cta_issue_blocked() 
+{
+    for( unsigned i=0; i < m_config->n_simt_cores_per_cluster; i++ ) {
+        kernel_info_t *kernel = m_core[i]->get_kernel();
+        if( m_core[i]->get_not_completed() == 0 && kernel == NULL ) 
+            return false; // would select a kernel
+        if( kernel && !kernel->no_more_ctas_to_run() && (m_core[i]->get_n_active_cta() < m_config->max_cta(*kernel)) ) 
+            return false;
+    }
+    return true;
+}
+
 unsigned simt_core_cluster::issue_block2core()
 {
     unsigned num_blocks_issued=0;
@@ -4511,6 +4915,18 @@ void simt_core_cluster::cache_flush()
         m_core[i]->cache_flush();
 }
 
+void simt_core_cluster::save_checkpoint( FILE *fp ) const
+{
+    for( unsigned i=0; i < m_config->n_simt_cores_per_cluster; i++ ) 
+        m_core[i]->save_checkpoint(fp);
+}
+
+void simt_core_cluster::load_checkpoint( FILE *fp )
+{
+    for( unsigned i=0; i < m_config->n_simt_cores_per_cluster; i++ ) 
+        m_core[i]->load_checkpoint(fp);
+}
+
 bool simt_core_cluster::icnt_injection_buffer_full(unsigned size, bool write)
 {
     unsigned request_size = size;
@@ -4599,6 +5015,7 @@ void simt_core_cluster::icnt_cycle()
 	//    packet_size += mf->get_early_abort_addr_set().size() * 4;
 	//}
         m_stats->m_incoming_traffic_stats->record_traffic(mf, packet_size); 
+        m_stats->m_incoming_traffic_stats->record_latency(mf, gpu_sim_cycle+gpu_tot_sim_cycle - mf->get_status_change()); 
         mf->set_status(IN_CLUSTER_TO_SHADER_QUEUE,gpu_sim_cycle+gpu_tot_sim_cycle);
         //m_memory_stats->memlatstat_read_done(mf,m_shader_config->max_warps_per_shader);
         m_response_fifo.push_back(mf);
@@ -4748,6 +5165,17 @@ void tx_log_walker_stats::print( FILE *fout ) const
    fprintf(fout, "TLW_n_cu_pass_msg = %u\n", n_cu_pass_msg);
    fprintf(fout, "TLW_n_warp_commit_attempt = %u\n", n_warp_commit_attempt);
    fprintf(fout, "TLW_n_warp_commit_read_only = %u\n", n_warp_commit_read_only);
+   fprintf(fout, "TLW_n_read_only_fast_commit = %u\n", n_read_only_fast_commit);
+   fprintf(fout, "TLW_n_read_only_fast_commit_tx = %u\n", n_read_only_fast_commit_tx);
+   fprintf(fout, "TLW_n_read_only_fast_commit_msg_saved = %u\n", n_read_only_fast_commit_msg_saved);
+   fprintf(fout, "TLW_n_log_buffer_write = %u\n", n_log_buffer_write);
+   fprintf(fout, "TLW_n_log_buffer_read = %u\n", n_log_buffer_read);
+   fprintf(fout, "TLW_n_log_buffer_spill_write = %u\n", n_log_buffer_spill_write);
+   fprintf(fout, "TLW_n_log_buffer_spill_read = %u\n", n_log_buffer_spill_read);
+   fprintf(fout, "TLW_n_log_buffer_bank_conflict = %u\n", n_log_buffer_bank_conflict);
+   fprintf(fout, "TLW_n_early_commit_release = %u\n", n_early_commit_release);
+   fprintf(fout, "TLW_n_early_commit_release_cycle_saved = %u\n", n_early_commit_release_cycle_saved);
+   fprintf(fout, "TLW_n_early_commit_release_stall = %u\n", n_early_commit_release_stall);
    fprintf(fout, "TLW_n_pre_commit_validation_abort = %u\n", n_pre_commit_validation_abort);
    fprintf(fout, "TLW_n_pre_commit_validation_pass = %u\n", n_pre_commit_validation_pass);
    fprintf(fout, "TLW_n_intra_warp_conflicts_detected = %u\n", n_intra_warp_conflicts_detected); 
@@ -4767,6 +5195,9 @@ void tx_log_walker_stats::print( FILE *fout ) const
    m_coalesced_packet_size.fprint(fout); fprintf(fout, "\n"); 
    m_warp_read_log_size.fprint(fout); fprintf(fout, "\n"); 
    m_warp_write_log_size.fprint(fout); fprintf(fout, "\n"); 
+   m_log_buffer_occupancy.fprint(fout); fprintf(fout, "\n"); 
+   m_lane_release_latency.fprint(fout); fprintf(fout, "\n"); 
+   m_lane_wait_for_slowest.fprint(fout); fprintf(fout, "\n"); 
 
    for (auto iter = m_sent_icnt_traffic.begin(); iter != m_sent_icnt_traffic.end(); ++iter) {
       fprintf(fout, "TLW_sent_icnt_traffic[%d] = %u\n", iter->first, *(iter->second)); 
@@ -4779,6 +5210,66 @@ void tx_log_walker_stats::print( FILE *fout ) const
    fprintf(fout, "TLW_intra_warp_cd_cycle_max = %u\n", TLW_intra_warp_cd_cycle_max); 
 }
 
+tx_log_buffer::tx_log_buffer(unsigned size, unsigned block_size, unsigned n_banks, unsigned n_warps, bool partitioned)
+   : m_block_size(block_size), m_n_blocks(size / block_size), m_n_banks(n_banks), 
+     m_warp_quota((partitioned)? (size / block_size) / n_warps : (size / block_size)), 
+     m_warp_blocks(n_warps, 0), m_bank_access(n_banks, (unsigned long long)-1)
+{
+   assert(m_n_banks > 0); 
+   assert(m_warp_quota > 0); 
+}
+
+// each bank services one access per cycle 
+bool tx_log_buffer::claim_bank(unsigned b, unsigned long long time)
+{
+   if (m_bank_access[b] == time) 
+      return false; 
+   m_bank_access[b] = time; 
+   return true; 
+}
+
+// allocate the block on first write; spill to L1D if the buffer (or the warp's partition) is full 
+enum tx_log_buffer::status_t tx_log_buffer::write(unsigned warp_id, new_addr_type addr, unsigned long long time)
+{
+   new_addr_type block = block_addr(addr); 
+   std::map<new_addr_type, unsigned>::iterator iter = m_resident.find(block); 
+   if (iter == m_resident.end()) {
+      if (m_resident.size() >= m_n_blocks or m_warp_blocks[warp_id] >= m_warp_quota) 
+         return LB_SPILL; 
+   }
+   if (not claim_bank(bank(block), time)) 
+      return LB_BANK_CONFLICT; 
+   if (iter == m_resident.end()) {
+      m_resident[block] = warp_id; 
+      m_warp_blocks[warp_id] += 1; 
+   }
+   return LB_HIT; 
+}
+
+enum tx_log_buffer::status_t tx_log_buffer::read(unsigned warp_id, new_addr_type addr, unsigned long long time)
+{
+   new_addr_type block = block_addr(addr); 
+   if (m_resident.count(block) == 0) 
+      return LB_SPILL; 
+   assert(m_resident[block] == warp_id); 
+   if (not claim_bank(bank(block), time)) 
+      return LB_BANK_CONFLICT; 
+   return LB_HIT; 
+}
+
+void tx_log_buffer::release(unsigned warp_id)
+{
+   if (m_warp_blocks[warp_id] == 0) return; 
+   std::map<new_addr_type, unsigned>::iterator iter = m_resident.begin(); 
+   while (iter != m_resident.end()) {
+      if (iter->second == warp_id) 
+         m_resident.erase(iter++); 
+      else 
+         ++iter; 
+   }
+   m_warp_blocks[warp_id] = 0; 
+}
+
 bool TLW_logging = false; 
 
 bool tlw_watched(int m_commit_id)
@@ -4798,7 +5289,7 @@ tx_log_walker::tx_log_walker(shader_core_ctx *core,
                              tx_log_walker_stats &stats) 
    : m_core_config(core_config), m_memory_config(memory_config), m_core(core), m_core_stats(core_stats), 
      m_warp(m_core->get_warps()), 
-     m_L1D(L1D), m_icnt(icnt), m_mf_alloc(mf_alloc), m_stats(stats), 
+     m_L1D(L1D), m_log_buffer(NULL), m_icnt(icnt), m_mf_alloc(mf_alloc), m_stats(stats), 
      m_sent_icnt_traffic(0), 
      m_core_id(core_id), m_cluster_id(cluster_id), 
      m_warp_size(m_core->get_config()->warp_size), 
@@ -4814,11 +5305,38 @@ tx_log_walker::tx_log_walker(shader_core_ctx *core,
       m_timelinef = NULL; 
    }
    stats.m_sent_icnt_traffic[m_core_id] = &m_sent_icnt_traffic; 
+
+   if (m_core_config->tlw_log_buffer_size > 0) {
+      const unsigned word_size = 4; 
+      m_log_buffer = new tx_log_buffer(m_core_config->tlw_log_buffer_size, word_size * m_warp_size, 
+                                       m_core_config->tlw_log_buffer_banks, m_core->get_config()->max_warps_per_shader, 
+                                       (m_core_config->tlw_log_buffer_spill_policy == 1)); 
+   }
 }
 
 tx_log_walker::~tx_log_walker()
 {
    fclose(m_timelinef); 
+   delete m_log_buffer; 
+}
+
+// read a log block from the dedicated log buffer 
+// return: true = handled by log buffer (block_read set on hit), false = block spilled, read it from L1D 
+bool tx_log_walker::log_buffer_read( unsigned warp_id, addr_t block, bool &block_read )
+{
+   if (m_log_buffer == NULL) return false; 
+   enum tx_log_buffer::status_t status = m_log_buffer->read(warp_id, block, gpu_sim_cycle + gpu_tot_sim_cycle); 
+   if (status == tx_log_buffer::LB_SPILL) {
+      m_stats.n_log_buffer_spill_read++; 
+      return false; 
+   }
+   if (status == tx_log_buffer::LB_HIT) {
+      m_stats.n_log_buffer_read++; 
+      block_read = true; 
+   } else {
+      m_stats.n_log_buffer_bank_conflict++; // try again next cycle 
+   }
+   return true; 
 }
 
 bool tx_log_walker::commit_tx_t::read_log_sent() { return m_read_log_send_q.empty(); }
@@ -4949,83 +5467,87 @@ bool tx_log_walker::send_log_entry( const warp_inst_t& inst, unsigned thread_id,
    if (log_send.atag_read == false and log_send.atag_cachemiss == false) {
       // generate access to entry's address field
       addr_t atag_block = m_core->translate_local_memaddr(entry_id * 2 * word_size + log_offset, wtid, addr_size); 
-      mem_access_t atag_access(LOCAL_ACC_R, atag_block, atag_block_size, false, empty_mask, full_byte_mask);
-      mem_fetch *atag_mf = m_mf_alloc->alloc(inst, atag_access);
-
-      std::list<cache_event> events;
-      enum cache_request_status status = m_L1D->access(atag_mf->get_addr(),atag_mf,gpu_sim_cycle+gpu_tot_sim_cycle,events);
-      m_stats.n_atag_read++; 
-
-      bool write_sent = was_write_sent(events);
-      bool read_sent = was_read_sent(events);
-      if( write_sent ) { 
-          m_core->inc_store_req( inst.warp_id() ); // eviction 
-      }
-      if ( status == HIT ) {
-          assert( !read_sent );
-          assert( !write_sent );
-          m_L1D->mark_last_use(atag_mf->get_addr()); 
-          delete atag_mf; 
-          log_send.atag_read = true; 
-      } else if ( status == RESERVATION_FAIL ) {
-          assert( !read_sent );
-          assert( !write_sent );
-          delete atag_mf;
-          m_stats.n_atag_cachercf++; 
-      } else {
-          assert( status == MISS || status == HIT_RESERVED );
-          m_extra_mf_fields[atag_mf] = extra_mf_fields(warp_id, thread_id, log_send.log_type, ATAG_READ); 
-          m_stats.n_atag_cachemiss++; 
-          log_send.atag_cachemiss = true; // don't try again until this flag is cleared 
-          // cmt_warp.signal_stalled(); 
+      if (log_buffer_read(warp_id, atag_block, log_send.atag_read) == false) {
+         mem_access_t atag_access(LOCAL_ACC_R, atag_block, atag_block_size, false, empty_mask, full_byte_mask);
+         mem_fetch *atag_mf = m_mf_alloc->alloc(inst, atag_access);
+
+         std::list<cache_event> events;
+         enum cache_request_status status = m_L1D->access(atag_mf->get_addr(),atag_mf,gpu_sim_cycle+gpu_tot_sim_cycle,events);
+         m_stats.n_atag_read++; 
+
+         bool write_sent = was_write_sent(events);
+         bool read_sent = was_read_sent(events);
+         if( write_sent ) { 
+             m_core->inc_store_req( inst.warp_id() ); // eviction 
+         }
+         if ( status == HIT ) {
+             assert( !read_sent );
+             assert( !write_sent );
+             m_L1D->mark_last_use(atag_mf->get_addr()); 
+             delete atag_mf; 
+             log_send.atag_read = true; 
+         } else if ( status == RESERVATION_FAIL ) {
+             assert( !read_sent );
+             assert( !write_sent );
+             delete atag_mf;
+             m_stats.n_atag_cachercf++; 
+         } else {
+             assert( status == MISS || status == HIT_RESERVED );
+             m_extra_mf_fields[atag_mf] = extra_mf_fields(warp_id, thread_id, log_send.log_type, ATAG_READ); 
+             m_stats.n_atag_cachemiss++; 
+             log_send.atag_cachemiss = true; // don't try again until this flag is cleared 
+             // cmt_warp.signal_stalled(); 
+         }
+         if (m_timelinef) 
+             fprintf(m_timelinef, "Log-read: warp%u RD %s-atag[%u] from [0x%08x], set=%u, outcome=%d @ %llu\n", 
+                     warp_id, ((log_send.log_type == READ_LOG_ACC)? "RS":"WS"), entry_id, atag_block, 
+                     m_core->get_config()->m_L1D_config.set_index(atag_block), status, 
+                     gpu_sim_cycle + gpu_tot_sim_cycle); 
+         cache_accessed = true; 
       }
-      if (m_timelinef) 
-          fprintf(m_timelinef, "Log-read: warp%u RD %s-atag[%u] from [0x%08x], set=%u, outcome=%d @ %llu\n", 
-                  warp_id, ((log_send.log_type == READ_LOG_ACC)? "RS":"WS"), entry_id, atag_block, 
-                  m_core->get_config()->m_L1D_config.set_index(atag_block), status, 
-                  gpu_sim_cycle + gpu_tot_sim_cycle); 
-      cache_accessed = true; 
    }
 
    if (log_send.data_read == false and log_send.data_cachemiss == false) {
       // generate access to entry's data field
       addr_t data_block = m_core->translate_local_memaddr((entry_id * 2 + 1) * word_size + log_offset, wtid, word_size); 
-      mem_access_t data_access(LOCAL_ACC_R, data_block, data_block_size, false, empty_mask, full_byte_mask);
-      mem_fetch *data_mf = m_mf_alloc->alloc(inst, data_access);
-
-      std::list<cache_event> events;
-      enum cache_request_status status = m_L1D->access(data_mf->get_addr(),data_mf,gpu_sim_cycle+gpu_tot_sim_cycle,events);
-      m_stats.n_data_read++; 
-
-      bool write_sent = was_write_sent(events);
-      bool read_sent = was_read_sent(events);
-      if( write_sent ) { 
-          m_core->inc_store_req( inst.warp_id() ); // eviction 
-      }
-      if ( status == HIT ) {
-          assert( !read_sent );
-          assert( !write_sent );
-          m_L1D->mark_last_use(data_mf->get_addr()); 
-          delete data_mf; 
-          log_send.data_read = true; 
-      } else if ( status == RESERVATION_FAIL ) { // try again later 
-          assert( !read_sent );
-          assert( !write_sent );
-          delete data_mf;
-          m_stats.n_data_cachercf++; 
-      } else {
-          assert( status == MISS || status == HIT_RESERVED );
-          m_extra_mf_fields[data_mf] = extra_mf_fields(warp_id, thread_id, log_send.log_type, DATA_READ); 
-          m_stats.n_data_cachemiss++; 
-          log_send.data_cachemiss = true; // don't try again until this flag is cleared 
-          // cmt_warp.signal_stalled(); 
+      if (log_buffer_read(warp_id, data_block, log_send.data_read) == false) {
+         mem_access_t data_access(LOCAL_ACC_R, data_block, data_block_size, false, empty_mask, full_byte_mask);
+         mem_fetch *data_mf = m_mf_alloc->alloc(inst, data_access);
+
+         std::list<cache_event> events;
+         enum cache_request_status status = m_L1D->access(data_mf->get_addr(),data_mf,gpu_sim_cycle+gpu_tot_sim_cycle,events);
+         m_stats.n_data_read++; 
+
+         bool write_sent = was_write_sent(events);
+         bool read_sent = was_read_sent(events);
+         if( write_sent ) { 
+             m_core->inc_store_req( inst.warp_id() ); // eviction 
+         }
+         if ( status == HIT ) {
+             assert( !read_sent );
+             assert( !write_sent );
+             m_L1D->mark_last_use(data_mf->get_addr()); 
+             delete data_mf; 
+             log_send.data_read = true; 
+         } else if ( status == RESERVATION_FAIL ) { // try again later 
+             assert( !read_sent );
+             assert( !write_sent );
+             delete data_mf;
+             m_stats.n_data_cachercf++; 
+         } else {
+             assert( status == MISS || status == HIT_RESERVED );
+             m_extra_mf_fields[data_mf] = extra_mf_fields(warp_id, thread_id, log_send.log_type, DATA_READ); 
+             m_stats.n_data_cachemiss++; 
+             log_send.data_cachemiss = true; // don't try again until this flag is cleared 
+             // cmt_warp.signal_stalled(); 
+         }
+         if (m_timelinef) 
+             fprintf(m_timelinef, "Log-read: warp%u RD %s-data[%u] from [0x%08x], set=%u, outcome=%d @ %llu\n", 
+                     warp_id, ((log_send.log_type == READ_LOG_ACC)? "RS":"WS"), entry_id, data_block, 
+                     m_core->get_config()->m_L1D_config.set_index(data_block), status, 
+                     gpu_sim_cycle + gpu_tot_sim_cycle); 
+         cache_accessed = true; 
       }
-      if (m_timelinef) 
-          fprintf(m_timelinef, "Log-read: warp%u RD %s-data[%u] from [0x%08x], set=%u, outcome=%d @ %llu\n", 
-                  warp_id, ((log_send.log_type == READ_LOG_ACC)? "RS":"WS"), entry_id, data_block, 
-                  m_core->get_config()->m_L1D_config.set_index(data_block), status, 
-                  gpu_sim_cycle + gpu_tot_sim_cycle); 
-      cache_accessed = true; 
    }
 
    // once the entry is read, send log entry to commit unit 
@@ -5213,6 +5735,7 @@ void tx_log_walker::send_tx_pass_fail(warp_commit_tx_t &cmt_warp, int warp_id, i
    commit_tx_t &tp = cmt_warp.m_thread_state[thread_id % m_warp_size];
 
    tp.m_state = SEND_ACK_CLEANUP;
+   tp.m_outcome_time = gpu_sim_cycle + gpu_tot_sim_cycle; 
    // send TX_PASS or TX_FAIL message
    for (unsigned cu = 0; cu < m_memory_config->m_n_mem_sub_partition; cu++) {
       if(tp.m_sent_cu_entry.test(cu)) {
@@ -5480,6 +6003,26 @@ bool tx_log_walker::has_out_message() const
    return (not (m_out_txreply_queue.empty() and m_out_message_queue.empty())); 
 }
 
+bool tx_log_walker::idle() const 
+{
+   if (has_out_message() or not m_bg_commit_warps.empty() or not m_finish_commit_q.empty()) 
+      return false; 
+   for (size_t m = 0; m < m_coalescing_queue.size(); m++) {
+      if (not m_coalescing_queue[m].empty()) 
+         return false; 
+   }
+   return true; 
+}
+
+void tx_log_walker::skip_idle_cycles(unsigned n_cycles) 
+{
+   // out_message_queue_cycle() samples the empty queues 
+   for (unsigned c = 0; c < n_cycles; c++) {
+      m_stats.m_out_message_queue_size.add2bin(0);
+      m_stats.m_out_txreply_queue_size.add2bin(0);
+   }
+}
+
 void tx_log_walker::acquire_cid( unsigned wid, unsigned thread_id, commit_tx_t &tp )
 {
    tp.m_commit_id = warp_commit_tx_t::alloc_commit_id();
@@ -5871,6 +6414,7 @@ active_mask_t tx_log_walker::perfect_intra_warp_conflict_detection(warp_inst_t &
 
          if (t_tm_manager->has_conflict_with(s_tm_manager) == true) {
             abort_mask.set(s); 
+            s_tm_manager->set_abort_cause(TM_ABORT_INTRA_WARP, 0, 0); 
          }
       }
    }
@@ -6555,6 +7099,12 @@ bool tx_log_walker::process_commit(warp_inst_t &inst,
 
    warp_commit_tx_t &cmt_warp = m_committing_warp[wid]; 
 
+   // read-only fast path for logical timestamp TM: nothing to write back, so skip the commit unit round trip 
+   if (cmt_warp.active() == false and m_core_config->tlw_read_only_fast_commit and is_logical_read_only_commit(inst)) {
+      read_only_fast_commit(inst); 
+      return true; 
+   }
+
    if (cmt_warp.active() == false) {
       if (m_core_config->tlw_intra_warp_conflict_detection) {
          cmt_warp.m_iwcd_uarch_info.reset(); 
@@ -6588,6 +7138,12 @@ bool tx_log_walker::process_commit(warp_inst_t &inst,
       }
 
       m_bg_commit_warps.push_back(wid);
+   } else if (cmt_warp.m_released) {
+      // previous commit of this warp was released early and is still writing back 
+      m_stats.n_early_commit_release_stall += 1; 
+      stall_reason = COAL_STALL; 
+      access_type = G_MEM_ST; 
+      return false; 
    } else {
       assert(cmt_warp.has(inst)); 
    }
@@ -6596,6 +7152,59 @@ bool tx_log_walker::process_commit(warp_inst_t &inst,
    return true; 
 }
 
+// return true if every transaction in the committing warp is read-only and conflict free under logical timestamp TM 
+bool tx_log_walker::is_logical_read_only_commit(const warp_inst_t &inst)
+{
+   if (m_core_config->tlw_use_logical_temporal_cd == false) return false; 
+
+   unsigned wid = inst.warp_id(); 
+   if (inst.is_warp_level) {
+      unsigned index = m_core_id * m_core_config->max_warps_per_shader + wid;
+      if (logical_temporal_conflict_detector::get_singleton().warp_level_conflict_exist(index)) 
+         return false; 
+   }
+
+   bool has_tx = false; 
+   for (unsigned t = 0; t < m_warp_size; t++) {
+      if (inst.issued(t) == false) continue; 
+      int tid = wid * m_warp_size + t; 
+      tm_manager_inf *t_tm_manager = m_core->get_func_thread_info(tid)->get_tm_manager(); 
+      if (t_tm_manager == NULL) return false; 
+      if (t_tm_manager->get_n_write() > 0) return false; 
+      if (t_tm_manager->get_is_abort_need_clean() or t_tm_manager->logical_tx_aborted()) return false; 
+      if (inst.active(t) == false) return false; 
+      has_tx = true; 
+   }
+   return has_tx; 
+}
+
+// commit a read-only warp at the core side without entering the log walker state machine 
+void tx_log_walker::read_only_fast_commit(warp_inst_t &inst)
+{
+   unsigned wid = inst.warp_id(); 
+   unsigned n_tx = 0; 
+   for (unsigned t = 0; t < m_warp_size; t++) {
+      if (inst.issued(t) == false) continue; 
+      int tid = wid * m_warp_size + t; 
+      tm_manager_inf *t_tm_manager = m_core->get_func_thread_info(tid)->get_tm_manager(); 
+      t_tm_manager->commit_core_side(); // read-only: this also calls tm_commit() on the thread 
+      delete_ptx_thread_tm_manager(wid, t); 
+      s_n_commited += 1; 
+      n_tx += 1; 
+   }
+
+   // the regular path sends a TX_DONE_FILL/TX_SKIP per transaction to every commit unit, 
+   // which tx_log_walker_warpc_logical::done_send_ws coalesces into one packet per commit unit 
+   unsigned n_commit_unit = m_memory_config->m_n_mem_sub_partition; 
+   m_stats.n_read_only_fast_commit += 1; 
+   m_stats.n_read_only_fast_commit_tx += n_tx; 
+   m_stats.n_read_only_fast_commit_msg_saved += (m_core_config->tlw_coalesce_packets)? n_commit_unit : n_tx * n_commit_unit; 
+
+   m_finish_commit_q.push_front(inst); // need to do this to release the commit lock 
+   m_warp[wid].get_tm_warp_info().reset(); 
+   m_core->commit_warp_cleanup(wid); 
+}
+
 unsigned tx_log_walker::warp_commit_tx_t::s_next_commit_id = 1; // reserve 0?
 unsigned int tx_log_walker::warp_commit_tx_t::alloc_commit_id() { return s_next_commit_id++; }
 
@@ -6607,6 +7216,7 @@ void tx_log_walker::warp_commit_tx_t::init(const warp_inst_t &inst)
    m_need_logical_tm_restart = false; 
 
    m_inst = inst; // make copy of the commit instruction (for unlocking scoreboard)
+   m_start_time = gpu_sim_cycle + gpu_tot_sim_cycle; 
    m_intra_warp_cd_cycle_pending = m_iwcd_uarch_info.operation_cycles(); // intra warp cd timing 
 
    m_thread_state.resize(inst.warp_size()); 
@@ -6691,6 +7301,18 @@ bool tx_log_walker::warp_commit_tx_t::all_commit()
    return true; 
 }
 
+// every thread has its TX_PASS/TX_FAIL outcome, and retry throttling (if any) has elapsed 
+bool tx_log_walker::warp_commit_tx_t::all_outcome_known()
+{
+   for (unsigned t = 0; t < m_inst.warp_size(); t++) {
+      if (m_thread_state[t].m_state != IDLE and m_thread_state[t].m_state != SEND_ACK_CLEANUP)
+         return false; 
+   }
+   if (m_retry_delay != 0 and gpu_sim_cycle + gpu_tot_sim_cycle <= m_retry_delay) 
+      return false; 
+   return true; 
+}
+
 bool tx_log_walker::warp_commit_tx_t::all_replied()
 {
    // if there is any pending reply, then return false 
@@ -6824,6 +7446,14 @@ void tx_log_walker_warpc::access_log(iwcd_uarch_info::uarch_event & uevent, int
 
    // generate access to entry's address field
    addr_t atag_block = m_core->translate_local_memaddr(entry_id * 2 * word_size + log_offset, wtid, addr_size); 
+   bool atag_read = false; 
+   if (log_buffer_read(warp_id, atag_block, atag_read)) {
+       if (atag_read) {
+           uevent.m_started = true; 
+           uevent.m_done = true; 
+       }
+       return; 
+   }
    mem_access_t atag_access(LOCAL_ACC_R, atag_block, atag_block_size, false, empty_mask, full_byte_mask);
    mem_fetch *atag_mf = m_mf_alloc->alloc(cmt_warp.m_inst, atag_access);
 
@@ -7121,6 +7751,16 @@ void tx_log_walker_warpc::cycle()
    }; 
 
    if (cmt_warp.all_commit()) {
+      if (cmt_warp.m_released) {
+         // warp was released early, only the background write-back was left 
+         m_stats.n_early_commit_release_cycle_saved += (gpu_sim_cycle + gpu_tot_sim_cycle) - cmt_warp.m_released_time; 
+         m_bg_commit_warps.remove(wid); 
+         m_committing_warp[wid].reset(); 
+         m_core->release_tm_ownership(wid); 
+         return; 
+      }
+      record_lane_release(cmt_warp); 
+
       // finish commit push the commit instruction to finish queue to unlock scoreboard at writeback stage 
       m_finish_commit_q.push_front(m_committing_warp[wid].m_inst); 
       m_bg_commit_warps.remove(wid); 
@@ -7133,10 +7773,46 @@ void tx_log_walker_warpc::cycle()
 
       m_core->commit_warp_cleanup(wid); 
 
-   } else if (yield_next_warp or cmt_warp.all_sent()) {
-      // all request from this warp is sent yield to other warps to send logs  
-      m_bg_commit_warps.remove(wid); 
-      m_bg_commit_warps.push_back(wid); 
+   } else {
+      if (m_core_config->tlw_early_commit_release and not cmt_warp.m_released and cmt_warp.all_outcome_known()) {
+         early_commit_release(wid, cmt_warp); 
+      }
+      if (yield_next_warp or cmt_warp.all_sent()) {
+         // all request from this warp is sent yield to other warps to send logs  
+         m_bg_commit_warps.remove(wid); 
+         m_bg_commit_warps.push_back(wid); 
+      }
+   }
+}
+
+// all threads in the warp know their outcome: unlock the commit instruction now and leave 
+// the remaining commit write-back (CU_DONE_COMMIT) to complete in background. The TM token and 
+// the fallback lock are kept until the write-back is done. 
+void tx_log_walker_warpc::early_commit_release(int wid, warp_commit_tx_t &cmt_warp)
+{
+   record_lane_release(cmt_warp); 
+   cmt_warp.m_released = true; 
+   cmt_warp.m_released_time = gpu_sim_cycle + gpu_tot_sim_cycle; 
+   m_stats.n_early_commit_release += 1; 
+
+   m_finish_commit_q.push_front(cmt_warp.m_inst); 
+   if (m_core->has_paused_threads(wid)) {
+       assert(g_tm_options.m_pause_and_go_enabled); 
+   } else {
+       m_warp[wid].get_tm_warp_info().reset();
+   }
+   m_core->commit_warp_cleanup(wid, true); 
+}
+
+// per-lane latency from commit start to warp release, and time each lane waited for the slowest lane 
+void tx_log_walker_warpc::record_lane_release(const warp_commit_tx_t &cmt_warp)
+{
+   unsigned long long release_time = gpu_sim_cycle + gpu_tot_sim_cycle; 
+   for (unsigned lane = 0; lane < m_warp_size; lane++) {
+      const commit_tx_t &tp = cmt_warp.m_thread_state[lane]; 
+      if (tp.m_commit_id == -1 or tp.m_outcome_time == 0) continue; 
+      m_stats.m_lane_release_latency.add2bin(release_time - cmt_warp.m_start_time); 
+      m_stats.m_lane_wait_for_slowest.add2bin(release_time - tp.m_outcome_time); 
    }
 }
 
@@ -7246,6 +7922,7 @@ void tx_log_walker_warpc::send_tx_pass_fail(warp_commit_tx_t &cmt_warp, int warp
          if (tp.m_commit_id == -1) continue; // ignore inactive lane
 
          tp.m_state = SEND_ACK_CLEANUP;
+         tp.m_outcome_time = gpu_sim_cycle + gpu_tot_sim_cycle; 
          if(tp.m_sent_cu_entry.test(cu)) {
             enum mf_type ack_type = (tp.m_pass)? TX_PASS : TX_FAIL;
             mem_fetch *tx_ack_mf = create_tx_packet(ack_type, cmt_warp.m_inst, tp.m_commit_id, cu, 0x600DACC, 0, false);
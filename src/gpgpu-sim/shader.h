@@ -523,10 +523,17 @@ public:
     // m_supervised_warps with their scheduling policies
     virtual void order_warps() = 0;
 
+    // Idle-cycle fast-forward of a core stalled on memory: the order only depends on the warp 
+    // state, so order_warps() gives the same list on every stalled cycle 
+    virtual bool stateless_order() const { return true; }
+    // issue stall statistics of n_cycles stalled cycles (no warp can issue or flush) 
+    void skip_stalled_cycles( unsigned n_cycles );
+
 protected:
     virtual void do_on_warp_issued( unsigned warp_id,
                                     unsigned num_issued,
                                     const std::vector< shd_warp_t* >::const_iterator& prioritized_iter );
+    void regroup_retry_warps( unsigned leader_wid, const warp_inst_t *pI, const warp_inst_t *leader_inst );
     inline int get_sid() const;
 protected:
     shd_warp_t& warp(int i);
@@ -613,6 +620,7 @@ public:
     }
 	virtual ~two_level_active_scheduler () {}
     virtual void order_warps();
+    virtual bool stateless_order() const { return false; } // demotes and promotes warps every cycle
 	void add_supervised_warp_id(int i) {
         if ( m_next_cycle_prioritized_warps.size() < m_max_active_warps ) {
             m_next_cycle_prioritized_warps.push_back( &warp(i) );
@@ -694,6 +702,11 @@ public:
         process_banks();
    }
 
+   // no collector unit allocated and no read queued 
+   bool idle() const;
+   // same as n_steps calls to step() on an idle operand collector 
+   void skip_idle_steps( unsigned n_steps ) { m_arbiter.skip_idle_steps(n_steps); }
+
    void dump( FILE *fp ) const
    {
       fprintf(fp,"\n");
@@ -938,6 +951,20 @@ private:
          for( unsigned b=0; b < m_num_banks; b++ ) 
             m_allocated_bank[b].reset();
       }
+      bool idle() const
+      {
+         for( unsigned b=0; b < m_num_banks; b++ ) {
+            if( !m_queue[b].empty() ) 
+               return false;
+         }
+         return true;
+      }
+      // allocate_reads() with no request only rotates the priority diagonal 
+      void skip_idle_steps( unsigned n_steps )
+      {
+         unsigned square = ( m_num_banks > m_num_collectors ) ? m_num_banks : m_num_collectors;
+         m_last_cu = ( m_last_cu + n_steps ) % square;
+      }
 
    private:
       unsigned m_num_banks;
@@ -1011,7 +1038,7 @@ private:
     	  return m_warp->get_num_regs();
       }
       void dispatch();
-      bool is_free(){return m_free;}
+      bool is_free() const {return m_free;}
 
    private:
       bool m_free;
@@ -1159,6 +1186,7 @@ public:
     virtual unsigned clock_multiplier() const { return 1; }
     virtual bool can_issue( const warp_inst_t &inst ) const { return m_dispatch_reg->empty() && !occupied.test(inst.latency); }
     virtual bool stallable() const = 0;
+    virtual bool idle() const { return m_dispatch_reg->empty() && occupied.none(); } // cycle() changes nothing 
     virtual void print( FILE *fp ) const
     {
         fprintf(fp,"%s dispatch= ", m_name.c_str() );
@@ -1218,6 +1246,14 @@ public:
     {
         return simd_function_unit::can_issue(inst);
     }
+    virtual bool idle() const
+    {
+        for( unsigned s=0; s < m_pipeline_depth; s++ ) {
+            if( !m_pipeline_reg[s]->empty() ) 
+                return false;
+        }
+        return simd_function_unit::idle();
+    }
     virtual void print(FILE *fp) const
     {
         simd_function_unit::print(fp);
@@ -1296,6 +1332,8 @@ public:
     void fill( mem_fetch *mf );
     void flush();
     void writeback();
+    void save_checkpoint( FILE *fp ) const;
+    void load_checkpoint( FILE *fp );
 
     // accessors
     virtual unsigned clock_multiplier() const;
@@ -1314,6 +1352,8 @@ public:
 
     virtual void active_lanes_in_pipeline();
     virtual bool stallable() const { return true; }
+    virtual bool idle() const; // also no response, writeback or cache and log walker work pending 
+    void skip_idle_cycles( unsigned n_cycles ); // same as n_cycles core cycles of an idle unit 
     bool response_buffer_full() const;
     void print(FILE *fout) const;
     void print_cache_stats( FILE *fp, unsigned& dl1_accesses, unsigned& dl1_misses );
@@ -1325,6 +1365,7 @@ public:
     void get_L1T_sub_stats(struct cache_sub_stats &css) const;
 
     bool has_message_pending() const; // either input or output message queue still has message in it
+    void release_tx_log_buffer(unsigned warp_id); // warp's transaction log is discarded 
 
     // Functions for the LSU HPCA2016 Early Abort paper
     void pause_and_go(mem_fetch *mf);
@@ -1366,6 +1407,7 @@ protected:
                                                       mem_fetch *mf,
                                                       enum cache_request_status status );
    mem_stage_stall_type process_memory_access_queue( cache_t *cache, warp_inst_t &inst );
+   bool process_log_buffer_access( warp_inst_t &inst, mem_stage_stall_type &stall_cond );
 
    const memory_config *m_memory_config;
    class mem_fetch_interface *&m_icnt;
@@ -1470,10 +1512,24 @@ struct shader_core_config : public core_config
            assert(tm_warp_scoreboard_token == true); 
            assert(tm_serial_pdom_stack == true); 
         }
+        if (tlw_early_commit_release and timing_mode_vb_commit) {
+           // the commit unit writes global memory at write-back, a released warp would read stale values 
+           printf("GPGPU-Sim uArch: Error ** -tlw_early_commit_release is not supported with -timing_mode_vb_commit\n");
+           abort();
+        }
         if (no_tx_log_gen) {
            assert(skip_tx_log_walker == true); 
            assert(timing_mode_vb_commit == false); 
         }
+        if (tlw_log_buffer_size > 0 and tlw_log_buffer_spill_policy == 1) {
+           // a partitioned log buffer needs at least one block (a word per lane) for every warp 
+           unsigned log_block_size = 4 * warp_size; 
+           if (tlw_log_buffer_size / log_block_size < max_warps_per_shader) {
+              printf("GPGPU-Sim uArch: Error ** -tlw_log_buffer_size %u is too small to partition among %u warps (needs at least %u bytes)\n", 
+                     tlw_log_buffer_size, max_warps_per_shader, log_block_size * max_warps_per_shader);
+              abort();
+           }
+        }
         m_valid = true;
     }
     void reg_options(class OptionParser * opp );
@@ -1589,6 +1645,13 @@ struct shader_core_config : public core_config
     bool tlw_tcd_whitelist_only; // validation before log traversal only pass and not abort tx 
 
     bool tlw_use_logical_temporal_cd; // use logical temporal conflict detection in pre-commit validation 
+    bool tlw_read_only_fast_commit; // commit read-only logical timestamp transactions at the core without commit unit messages 
+    bool tlw_early_commit_release; // release committing warp once all outcomes are known, commit write-back continues in background 
+    bool tm_retry_warp_regroup; // compact lanes of retrying transactions from warps in the same CTA into shared issue slots 
+
+    unsigned tlw_log_buffer_size; // size of dedicated transaction log buffer per core in bytes (0 = logs in L1D)
+    unsigned tlw_log_buffer_banks; // number of banks in the transaction log buffer 
+    unsigned tlw_log_buffer_spill_policy; // 0 = log buffer shared by all warps, 1 = statically partitioned among warps 
     
     bool tm_warp_level_gmem_view; // threads in transactional warp view the same global memory 
 
@@ -1671,6 +1734,12 @@ struct shader_core_stats_pod {
 
     // tx stats for sanity check 
     int gpgpu_n_tx_msg; 
+
+    // SIMD efficiency of retried transactions 
+    unsigned long long gpgpu_n_tx_retry_issue; // issue slots used by warps re-executing an aborted transaction 
+    unsigned long long gpgpu_n_tx_retry_lanes; // active lanes in those issue slots 
+    unsigned long long gpgpu_n_tx_retry_regrouped_insn; // warp instructions folded into another warp's issue slot 
+    unsigned long long gpgpu_n_tx_retry_remapped_lanes; // lanes of those instructions moved to another SIMD lane 
     
     // thread state profiling
     // Aggregate stats for all threads
@@ -1798,6 +1867,8 @@ public:
     void reinit(unsigned start_thread, unsigned end_thread, bool reset_not_completed );
     void issue_block2core( class kernel_info_t &kernel );
     void cache_flush();
+    void save_checkpoint( FILE *fp ) const;
+    void load_checkpoint( FILE *fp );
     void accept_fetch_response( mem_fetch *mf );
     void accept_ldst_unit_response( class mem_fetch * mf );
     void set_kernel( kernel_info_t *k ); 
@@ -1834,6 +1905,10 @@ public:
     virtual bool warp_waiting_at_barrier( unsigned warp_id ) const;
     void get_pdom_stack_top_info( unsigned tid, unsigned *pc, unsigned *rpc ) const;
     bool has_message_pending() const { return m_ldst_unit->has_message_pending(); }
+    // idle-cycle fast-forward while every warp waits on memory 
+    bool stalled_on_memory();
+    float stalled_duty_cycle() const;
+    void skip_stalled_cycles( unsigned n_cycles );
 
 // used by pipeline timing model components:
     // modifiers
@@ -1975,7 +2050,9 @@ public:
    virtual void rollback_callback( unsigned thread_id, unsigned warp_id, address_type pc ); //HACK: will roll the whole warp back
 
    void initiate_timing_model_transaction_commit( unsigned warp_id ); 
-   void commit_warp_cleanup(unsigned warp_id); // clean up the uarch state after a warp has finished commit 
+   void commit_warp_cleanup(unsigned warp_id, bool keep_tm_ownership = false); // clean up the uarch state after a warp has finished commit 
+   void release_tm_ownership(unsigned warp_id); // release TM token and fallback lock once commit write-back is done 
+   void release_tx_log_buffer(unsigned warp_id); // free warp's blocks in the transaction log buffer 
 
    unsigned get_tm_uarch_model() const { return m_config->tm_uarch_model; }
 
@@ -2032,7 +2109,9 @@ private:
     friend class LooseRoundRobbinScheduler;
     active_mask_t warps_need_clean_num_writing(unsigned wid);
     void issue_warp_dummy_commit( register_set& warp, const warp_inst_t *pI, const active_mask_t &active_mask, unsigned warp_id );
-    void issue_warp( register_set& warp, const warp_inst_t *pI, const active_mask_t &active_mask, unsigned warp_id );
+    warp_inst_t* issue_warp( register_set& warp, const warp_inst_t *pI, const active_mask_t &active_mask, unsigned warp_id );
+    void issue_warp_regrouped( const warp_inst_t *leader_inst, const warp_inst_t *pI, const active_mask_t &active_mask, unsigned warp_id, active_mask_t &slot_mask );
+    void complete_regrouped_insts( const warp_inst_t &leader_inst );
     void func_exec_inst( warp_inst_t &inst );
 
     void read_operands();
@@ -2086,6 +2165,8 @@ private:
 
     //schedule
     std::vector<scheduler_unit*>  schedulers;
+    // instructions of retrying warps regrouped into a leader's issue slot, indexed by leader uid 
+    std::map<unsigned, std::list<warp_inst_t> > m_regrouped_retry_insts; 
 
     // execute
     unsigned m_num_function_units;
@@ -2124,6 +2205,8 @@ public:
     void reinit();
     unsigned issue_block2core();
     void cache_flush();
+    void save_checkpoint( FILE *fp ) const;
+    void load_checkpoint( FILE *fp );
     bool icnt_injection_buffer_full(unsigned size, bool write);
     void icnt_inject_request_packet(class mem_fetch *mf);
 
@@ -2141,8 +2224,15 @@ public:
     bool has_io_pending() const; 
     void print_not_completed( FILE *fp ) const;
     unsigned get_n_active_cta() const;
+    unsigned get_core_n_active_cta( unsigned cid ) const { return m_core[cid]->get_n_active_cta(); }
     unsigned get_n_active_sms() const;
     gpgpu_sim *get_gpu() { return m_gpu; }
+
+    // idle-cycle fast-forward while every core waits on memory 
+    bool stalled_on_memory();
+    void skip_stalled_cycles( unsigned n_cycles );
+    void skipped_duty_cycles( bool stalled, float &first, float &steady ) const;
+    bool cta_issue_blocked();
     ptx_thread_info *get_functional_thread( unsigned sid)
     {
         unsigned cid = m_config->sid_to_cid(sid);
@@ -2220,6 +2310,40 @@ private:
 
 inline int scheduler_unit::get_sid() const { return m_shader->get_sid(); }
 
+// dedicated per-core storage for transaction logs, so that log traffic does not compete with data in L1D
+// models capacity and bank conflicts only; blocks that do not fit spill to L1D 
+class tx_log_buffer
+{
+public:
+   enum status_t {
+      LB_HIT = 0,
+      LB_BANK_CONFLICT,
+      LB_SPILL
+   };
+
+   tx_log_buffer(unsigned size, unsigned block_size, unsigned n_banks, unsigned n_warps, bool partitioned); 
+
+   enum status_t write(unsigned warp_id, new_addr_type addr, unsigned long long time); 
+   enum status_t read(unsigned warp_id, new_addr_type addr, unsigned long long time); 
+   void release(unsigned warp_id); // free all blocks used by the warp's log 
+
+   unsigned occupancy() const { return m_resident.size(); }
+   unsigned capacity() const { return m_n_blocks; }
+
+private:
+   new_addr_type block_addr(new_addr_type addr) const { return addr - (addr % m_block_size); }
+   unsigned bank(new_addr_type block) const { return (block / m_block_size) % m_n_banks; }
+   bool claim_bank(unsigned b, unsigned long long time); 
+
+   const unsigned m_block_size; 
+   const unsigned m_n_blocks; 
+   const unsigned m_n_banks; 
+   const unsigned m_warp_quota; // maximum number of blocks per warp 
+   std::map<new_addr_type, unsigned> m_resident; // resident block -> owner warp 
+   std::vector<unsigned> m_warp_blocks; // number of resident blocks per warp 
+   std::vector<unsigned long long> m_bank_access; // cycle of last access to each bank 
+};
+
 class warp_commit_tx_t;
 // the core-side unit that sends read-set and write-set to MP-side commit unit at commit 
 class tx_log_walker
@@ -2256,9 +2380,14 @@ public:
    virtual void done_send_ws(warp_commit_tx_t &cmt_warp) {}; 
    // output message in its queue to be flushed out
    bool has_out_message() const;  
+   // no warp committing and no message or commit outcome left: cycle() only samples the queues 
+   bool idle() const; 
+   void skip_idle_cycles(unsigned n_cycles); 
 
    unsigned get_sent_icnt_traffic() const { return m_sent_icnt_traffic; }
 
+   tx_log_buffer* get_log_buffer() { return m_log_buffer; } // NULL if logs are kept in L1D 
+
 protected:
    const shader_core_config *m_core_config; 
    const memory_config *m_memory_config; 
@@ -2266,6 +2395,7 @@ protected:
    shader_core_stats &m_core_stats; // for power model stats 
    std::vector<shd_warp_t>& m_warp;
    data_cache *m_L1D; // for log access
+   tx_log_buffer *m_log_buffer; // dedicated log storage, log accesses that miss here go to L1D 
    class mem_fetch_interface *&m_icnt;
    mem_fetch_allocator *m_mf_alloc; 
    FILE *m_timelinef;
@@ -2452,6 +2582,7 @@ protected:
       unsigned m_cu_reply_time_start; 
       unsigned m_cu_reply_time_end; 
       bool m_cu_reply_started; 
+      unsigned long long m_outcome_time; // when TX_PASS/TX_FAIL was decided for this thread 
 
       void enter_write_cu_reply(unsigned n_commit_unit);
 
@@ -2486,6 +2617,7 @@ protected:
          m_cu_reply_time_start = 0;
          m_cu_reply_time_end = 0;
          m_cu_reply_started = false; 
+         m_outcome_time = 0; 
          delete_tm_manager(); 
       }
 
@@ -2526,6 +2658,9 @@ protected:
       warp_inst_t m_inst; 
 
       unsigned long long m_retry_delay; // for throttling transaction retry 
+      unsigned long long m_start_time; // when the commit entered the log walker 
+      bool m_released; // commit instruction already released to the warp (early commit release) 
+      unsigned long long m_released_time; 
 
       iwcd_uarch_info m_iwcd_uarch_info; // info for intra warp cd timing model 
       int m_intra_warp_cd_cycle_pending; // approx model for intra warp cd overhead
@@ -2541,6 +2676,9 @@ protected:
          m_thread_processing = -1;  
          m_inst.clear(); 
          m_retry_delay = 0;
+         m_start_time = 0; 
+         m_released = false; 
+         m_released_time = 0; 
          m_iwcd_uarch_info.reset(); 
          m_intra_warp_cd_cycle_pending = 0;
 	 m_need_logical_tm_restart = false; 
@@ -2563,6 +2701,7 @@ protected:
       bool all_sent(); 
       bool all_replied(); 
       bool all_commit(); 
+      bool all_outcome_known(); 
 
       int perform_intra_warp_cd_cycle(); 
 
@@ -2587,6 +2726,7 @@ protected:
    // cu_accessed = commit unit id that log was sent to
    bool send_log_entry( const warp_inst_t& inst, unsigned thread_id, int commit_id, 
                         log_send_status_t &log_send, bool &cache_accessed, unsigned &cu_accessed, bool aborted = false);
+   bool log_buffer_read( unsigned warp_id, addr_t block, bool &block_read ); 
 
    // coalescing queue - for coalescing the read-set/write-set packets according to the memory partition 
    std::vector< std::list<mem_fetch*> > m_coalescing_queue;
@@ -2636,6 +2776,9 @@ protected:
 
    // each thread in the warp do a validation (without timing/traffic) and abort if fail
    void pre_commit_validation(warp_inst_t &inst); 
+   // read-only fast path for logical timestamp TM: detect a read-only warp and commit it at the core 
+   bool is_logical_read_only_commit(const warp_inst_t &inst); 
+   void read_only_fast_commit(warp_inst_t &inst); 
    // undirty every cache line that contains the log 
    void clear_log_cache_usage(unsigned warp_id, const tm_warp_info &warp_info, bool read_log); 
 
@@ -2705,6 +2848,10 @@ protected:
    // helper function to access log entry in cache 
    void access_log(iwcd_uarch_info::uarch_event & uevent, int wid, warp_commit_tx_t &cmt_warp); 
 
+   // release the commit instruction to the warp once every thread has its outcome 
+   void early_commit_release(int wid, warp_commit_tx_t &cmt_warp); 
+   void record_lane_release(const warp_commit_tx_t &cmt_warp); 
+
    // return the highest priority warp that is ready for action 
    int select_active_warp(); 
    // allocate intra warp conflict detection resource 
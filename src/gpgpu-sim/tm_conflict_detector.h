@@ -146,8 +146,7 @@ public:
 #endif
                        blk.m_marked = false;
                        blk.m_valid = false;
-                       cache_block_t &tag = m_tags.get_block(idx);
-                       tag.invalidate();
+                       m_tags.invalidate(idx);
                     }
                     m_invalidate_count+=invalidates_sent;
                 }
@@ -171,8 +170,7 @@ public:
             if( blk.m_read_set.none() ) {
                 blk.m_marked = false;
                 blk.m_valid = false;
-                cache_block_t &tag = m_tags.get_block(index);
-                tag.invalidate();
+                m_tags.invalidate(index);
 #ifdef DEBUG_TM
             printf(" [tm conf. det.] [part=%u] TR_INVALIDATE_ACK (tid=%u) : clearing mark on idx=%u\n", m_partition_id, tid, index );
 #endif
@@ -214,8 +212,7 @@ public:
                     blk.m_marked = false;
                 blk.m_read_set.reset(sid);
                 if( blk.m_read_set.none() && !blk.m_marked ) {
-                    cache_block_t &tag = m_tags.get_block(idx);
-                    tag.invalidate();
+                    m_tags.invalidate(idx);
                     blk.m_valid = false;
                 }
             }
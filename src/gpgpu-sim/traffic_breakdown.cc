@@ -1,6 +1,14 @@
 #include "traffic_breakdown.h" 
 #include "mem_fetch.h" 
 
+traffic_breakdown::traffic_breakdown(const std::string &network_name) 
+: m_network_name(network_name) 
+{
+   for (unsigned c = 0; c < N_ICNT_MSG_CLASS; c++) {
+      m_latency_hist.push_back(pow2_histogram("traffic_latency_" + network_name + "_" + icnt_msg_class_str[c])); 
+   }
+}
+
 void traffic_breakdown::print(FILE* fout)
 {
    unsigned int tot_traffic = 0;
@@ -17,6 +25,10 @@ void traffic_breakdown::print(FILE* fout)
       fprintf(fout, "}\n"); 
    }
    fprintf(fout, "%s_total_traffic = %u\n", m_network_name.c_str(), tot_traffic);
+   for (unsigned c = 0; c < N_ICNT_MSG_CLASS; c++) {
+      m_latency_hist[c].fprint(fout); 
+      fprintf(fout, "\n"); 
+   }
 }
 
 void traffic_breakdown::record_traffic(class mem_fetch * mf, unsigned int size) 
@@ -24,6 +36,11 @@ void traffic_breakdown::record_traffic(class mem_fetch * mf, unsigned int size)
    m_stats[classify_memfetch(mf)][size] += 1; 
 }
 
+void traffic_breakdown::record_latency(class mem_fetch * mf, unsigned long long latency) 
+{
+   m_latency_hist[mf->get_icnt_msg_class()].add2bin(latency); 
+}
+
 std::string traffic_breakdown::classify_memfetch(class mem_fetch * mf)
 {
    std::string traffic_name; 
@@ -3,14 +3,14 @@
 #include <stdio.h>
 #include <map>
 #include <string> 
+#include <vector>
+#include "histogram.h"
 
 // Breakdown traffic through the network according to category
 class traffic_breakdown
 {
 public: 
-   traffic_breakdown(const std::string &network_name) 
-   : m_network_name(network_name) 
-   { }
+   traffic_breakdown(const std::string &network_name); 
 
    // print the stats 
    void print(FILE* fout); 
@@ -18,6 +18,9 @@ public:
    // record the amount and type of traffic introduced by this mem_fetch object 
    void record_traffic(class mem_fetch * mf, unsigned int size); 
 
+   // record the cycles this mem_fetch object spent in the network, by message class 
+   void record_latency(class mem_fetch * mf, unsigned long long latency); 
+
 protected:
 
    std::string m_network_name; 
@@ -34,4 +37,6 @@ protected:
    typedef std::map < mf_packet_type, traffic_class_t > traffic_stat_t; 
 
    traffic_stat_t m_stats; 
+
+   std::vector<pow2_histogram> m_latency_hist; // indexed by icnt_msg_class 
 }; 
@@ -17,6 +17,7 @@
 #include "injection.hpp"
 #include "interconnect_interface.h"
 #include "../gpgpu-sim/mem_fetch.h"
+#include "../gpgpu-sim/icnt_wrapper.h"
 #include <string.h>
 #include <math.h>
 
@@ -300,22 +301,26 @@ void icnt_init_grid (){
    }
 }
 
-bool interconnect_has_buffer(unsigned int input_node, unsigned int tot_req_size) 
+static bool interconnect_has_flit_buffer(unsigned int input_node, unsigned int n_flits) 
 {
-
    unsigned int input = node_map[input_node];   
    bool has_buffer = false;
-   unsigned int n_flits = tot_req_size / _flit_size + ((tot_req_size % _flit_size)? 1:0);
    if (!(fixed_lat_icnt || perfect_icnt)) {
-      has_buffer = (traffic[0]->_partial_packets[input][0].size() + n_flits) <=  input_buffer_capacity; 
+      has_buffer = (traffic[0]->_QueuedFlits(input) + n_flits) <=  input_buffer_capacity; 
       if ((net_c>1) && is_mem(input)) 
-         has_buffer = (traffic[1]->_partial_packets[input][0].size() + n_flits) <=  input_buffer_capacity; 
+         has_buffer = (traffic[1]->_QueuedFlits(input) + n_flits) <=  input_buffer_capacity; 
    } else {
       has_buffer = true; 
    }
    return has_buffer;
 }
 
+bool interconnect_has_buffer(unsigned int input_node, unsigned int tot_req_size) 
+{
+   unsigned int n_flits = tot_req_size / _flit_size + ((tot_req_size % _flit_size)? 1:0);
+   return interconnect_has_flit_buffer(input_node, n_flits);
+}
+
 extern unsigned long long  gpu_sim_cycle;
 extern unsigned long long  gpu_tot_sim_cycle;
 
@@ -347,7 +352,8 @@ void interconnect_push ( unsigned int input_node, unsigned int output_node,
       } else {
          nc=1;
       }
-      traffic[nc]->_GeneratePacket( input, n_flits, 0 /*class*/, traffic[nc]->_time, data, output); 
+      int cl = icnt_high_priority(data)? 1 : 0; // class 1 wins allocation when priority = class
+      traffic[nc]->_GeneratePacket( input, n_flits, cl, traffic[nc]->_time, data, output); 
 #if DOUB
       cout <<"Traffic[" << nc << "] (mapped) sending form "<< input << " to " << output <<endl;
 #endif
@@ -450,6 +456,15 @@ void init_interconnect (char* config_file,
       traffic[i] = new TrafficManager ( icnt_config, net[i], i/*id*/ );
    }
 
+   if (g_icnt_tm_ctrl_priority) {
+      string priority;
+      icnt_config.GetStr( "priority", priority );
+      if (priority != "class") {
+         cout << "GPGPU-Sim uArch: ERROR ** -icnt_tm_ctrl_priority requires 'priority = class' in the interconnect config" << endl;
+         abort();
+      }
+   }
+
    fixed_lat_icnt = icnt_config.GetInt( "fixed_lat_per_hop" );
 
    if (icnt_config.GetInt( "perfect_icnt" )) {
@@ -488,19 +503,46 @@ void advance_interconnect ()
    }
 }
 
+// advance an idle interconnect by several cycles at once (caller checks interconnect_busy())
+void skip_interconnect(unsigned int cycles) 
+{
+   if (!fixed_lat_icnt) {
+      for (unsigned i=0;i<net_c;i++) {
+         traffic[i]->_SkipIdleSteps( cycles );
+      }
+   }
+}
+
+// earliest gpu_sim_cycle at which a fixed latency packet can be popped 
+// (packets in the booksim network are covered by interconnect_busy())
+unsigned long long interconnect_next_delivery()
+{
+   unsigned long long next_delivery = (unsigned long long)-1; 
+   if (fixed_lat_icnt) {
+      for (unsigned i=0;i<(_n_mem + _n_shader);i++) {
+         if (!out_buf_fixedlat_buf[i].empty()) {
+            unsigned long long receive_time = ((mem_fetch *)out_buf_fixedlat_buf[i].top())->get_icnt_receive_time();
+            if (receive_time < next_delivery) 
+               next_delivery = receive_time;
+         }
+      }
+   }
+   return next_delivery;
+}
+
 unsigned interconnect_busy()
 {
    unsigned i,j;
    for(i=0; i<net_c;i++) {
-      if (traffic[i]->_measured_in_flight) {
+      if (traffic[i]->_measured_in_flight || !traffic[i]->_ROBEmpty()) {
          return 1;
       }
    }
    for ( i=0 ;i<(_n_shader+_n_mem);i++ ) {
-		if ( !traffic[0]->_partial_packets[i] [0].empty() ) {
+		if ( traffic[0]->_QueuedFlits(i) ) {
 			return 1;
 		}
-		if ( doub_net && !traffic[1]->_partial_packets[i] [0].empty() ) {
+		if ( doub_net && traffic[1]->_QueuedFlits(i) ) {
 			return 1;
 		}
 		for ( j=0;j<g_num_vcs;j++ ) {
@@ -521,10 +563,10 @@ void display_icnt_state( FILE *fp )
    }
    
    for (unsigned i=0 ;i<(_n_shader+_n_mem);i++ ) {
-      if( !traffic[0]->_partial_packets[i] [0].empty() ) 
-         fprintf(fp,"   Network 0 has nonempty _partial_packets[%u][0]\n", i);
-		if ( doub_net && !traffic[1]->_partial_packets[i] [0].empty() ) 
-         fprintf(fp,"   Network 1 has nonempty _partial_packets[%u][0]\n", i);
+      if( traffic[0]->_QueuedFlits(i) ) 
+         fprintf(fp,"   Network 0 has nonempty _partial_packets[%u]\n", i);
+		if ( doub_net && traffic[1]->_QueuedFlits(i) ) 
+         fprintf(fp,"   Network 1 has nonempty _partial_packets[%u]\n", i);
 		for (unsigned j=0;j<g_num_vcs;j++ ) {
 			if( !ejection_buf[i][j].empty() )
             fprintf(fp,"   ejection_buf[%u][%u] is non-empty\n", i, j);
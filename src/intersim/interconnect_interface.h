@@ -21,7 +21,9 @@ void init_interconnect (char* config_file,
                         unsigned int n_shader, 
                         unsigned int n_mem);
 void advance_interconnect();
+void skip_interconnect(unsigned int cycles);
 unsigned interconnect_busy();
+unsigned long long interconnect_next_delivery();
 void interconnect_stats() ;
 
 //interconnect side functions
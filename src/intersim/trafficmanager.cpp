@@ -468,6 +468,7 @@ void TrafficManager::_GeneratePacket( int source, int psize /*# of flits*/ ,
          time++;
       }
 
+      // each class has its own source queue, so a higher class is not stuck behind lower class flits
       _partial_packets[source][cl].push_back( f );
    }
 }
@@ -606,40 +607,43 @@ void TrafficManager::_VOQInject( )
          psize = 0;
       }
 */
-      if ( !_partial_packets[input][0].empty( )/*was psize */) {
-         //_GeneratePacket( input, psize, 0, _time ); //already generated in interconnect_push
-         dest = -1;
+      // move the higher class first
+      for ( int c = _classes - 1; c >= 0; --c ) {
+         if ( !_partial_packets[input][c].empty( )/*was psize */) {
+            //_GeneratePacket( input, psize, 0, _time ); //already generated in interconnect_push
+            dest = -1;
+
+            bool wasempty = false;
+
+            // Move a generated packet to the appropriate VOQ
+            while ( !_partial_packets[input][c].empty( ) ) {
+               f = _partial_packets[input][c].front( );
+               _partial_packets[input][c].pop_front( );
+               time_vector_update_icnt_injected(f->data, input);
 
-         bool wasempty = false;
+               if ( f->head ) {
+                  dest = f->dest; 
+                  wasempty = _voq[input][dest].empty( );
+               }
 
-         // Move a generated packet to the appropriate VOQ
-         while ( !_partial_packets[input][0].empty( ) ) {
-            f = _partial_packets[input][0].front( );
-            _partial_packets[input][0].pop_front( );
-            time_vector_update_icnt_injected(f->data, input);
+               if ( dest == -1 ) {
+                  Error( "Didn't see head flit in VOQ injection" );
+               }
 
-            if ( f->head ) {
-               dest = f->dest; 
-               wasempty = _voq[input][dest].empty( );
-            }
+               f->dest = dest;
+               f->vc   = dest;
 
-            if ( dest == -1 ) {
-               Error( "Didn't see head flit in VOQ injection" );
+               _voq[input][dest].push_back( f );
             }
 
-            f->dest = dest;
-            f->vc   = dest;
-
-            _voq[input][dest].push_back( f );
-         }
-
-         // If this packet enables a VC,
-         // set the VC to active (append it to the active list)
-         if ( wasempty &&
-              ( !_active_vc[input][dest] ) && 
-              ( _buf_states[input]->IsAvailableFor( dest ) ) ) {
-            _active_list[input].push_back( dest );
-            _active_vc[input][dest] = true;
+            // If this packet enables a VC,
+            // set the VC to active (append it to the active list)
+            if ( wasempty &&
+                 ( !_active_vc[input][dest] ) && 
+                 ( _buf_states[input]->IsAvailableFor( dest ) ) ) {
+               _active_list[input].push_back( dest );
+               _active_vc[input][dest] = true;
+            }
          }
       }
 
@@ -829,6 +833,53 @@ void TrafficManager::_Step( )
    }
 }
 
+// Advances a drained network (no flits, partial packets or credits in flight) 
+// by several steps at once: such a step only advances time and samples an 
+// empty ejection at every output (with _reorder, from _ReadROB on an empty ROB) 
+void TrafficManager::_SkipIdleSteps( int steps )
+{
+   if ( !_ROBEmpty( ) ) {
+      Error( "Idle steps skipped with flits waiting in a reorder buffer" );
+   }
+   for ( int s = 0; s < steps; ++s ) {
+      _partial_internal_cycles += _internal_speedup;
+      while ( _partial_internal_cycles >= 1.0 ) {
+         _partial_internal_cycles -= 1.0;
+      }
+      if ( !_empty_network ) {
+         for ( int output = 0; output < _dests; ++output ) {
+            _accepted_packets[output]->AddSample( 0 );
+         }
+      }
+   }
+   _time += steps;
+}
+
+// no flit waits in a reorder buffer for an earlier one
+bool TrafficManager::_ROBEmpty( ) const
+{
+   if ( _reorder ) {
+      for ( int src = 0; src < _sources; ++src ) {
+         for ( int dest = 0; dest < _dests; ++dest ) {
+            if ( !_rob[src][dest].empty( ) ) {
+               return false;
+            }
+         }
+      }
+   }
+   return true;
+}
+
+// flits generated at a source and not yet injected, over all classes
+int TrafficManager::_QueuedFlits( int source ) const
+{
+   int n_flits = 0;
+   for ( int c = 0; c < _classes; ++c ) {
+      n_flits += _partial_packets[source][c].size( );
+   }
+   return n_flits;
+}
+
 bool TrafficManager::_PacketsOutstanding( ) const
 {
    bool outstanding;
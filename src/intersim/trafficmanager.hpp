@@ -140,10 +140,13 @@ public:
 
    void _FirstStep( );
    void _Step( );
+   void _SkipIdleSteps( int steps );
 
    Flit *_ReadROB( int dest );
 
    bool _PacketsOutstanding( ) const;
+   int  _QueuedFlits( int source ) const;
+   bool _ROBEmpty( ) const;
 
    int  _IssuePacket( int source, int cl ) const;
    void _GeneratePacket( int source, int size, int cl, int time, void* data, int dest );
@@ -153,10 +153,23 @@ void stream_operation::do_operation( gpgpu_sim *gpu )
     case stream_kernel_launch:
         if( gpu->can_start_kernel() ) {
         	gpu->set_cache_config(m_kernel->name());
+            if( gpu->skip_kernel_before_resume(*m_kernel) ) {
+                // state at the end of this kernel is restored from the checkpoint
+                gpu->restore_memory_for_skipped_kernel();
+                printf("kernel \'%s\' (uid %u) skipped, its results are restored from the checkpoint\n", 
+                       m_kernel->name().c_str(), m_kernel->get_uid() );
+                extern stream_manager *g_stream_manager;
+                g_stream_manager->register_finished_kernel(m_kernel->get_uid());
+                break;
+            }
+            gpu->checkpoint_at_launch(*m_kernel);
         	printf("kernel \'%s\' transfer to GPU hardware scheduler\n", m_kernel->name().c_str() );
             if( m_sim_mode )
                 gpgpu_cuda_ptx_sim_main_func( *m_kernel );
-            else
+            else if( gpu->fast_forward_to_roi(*m_kernel) ) {
+                extern stream_manager *g_stream_manager;
+                g_stream_manager->register_finished_kernel(m_kernel->get_uid());
+            } else
                 gpu->launch( m_kernel );
         }
         break;